@@ -66,6 +66,8 @@ Item {
         }
         width: Theme.iconSizeLauncher
         height: Theme.iconSizeLauncher
+        sourceSize.width: Theme.iconSizeLauncher
+        sourceSize.height: Theme.iconSizeLauncher
         fillMode: Image.PreserveAspectFit
     }
 }
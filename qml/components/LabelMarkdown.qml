@@ -1,33 +1,21 @@
 import QtQuick 2.0
 import Sailfish.Silica 1.0
+import org.chum 1.0
 
 import ".."
 
 Label {
-    property bool fetching: false
-    property var  url
+    property bool fetching: renderer.loading
+    property alias url: renderer.url
 
     textFormat: Text.RichText
-    Component.onCompleted: fetch()
-    onUrlChanged: fetch()
+    text: renderer.loading ?
+              //% "Loading..."
+              qsTrId("chum-loading-text") :
+              renderer.text
 
-    function fetch() {
-        if (!url) {
-            text = "";
-            return;
-        }
-
-        fetching = true;
-        //% "Loading..."
-        text = qsTrId("chum-loading-text");
-        var xhr = new XMLHttpRequest;
-        xhr.open("GET", url);
-        xhr.onreadystatechange = function() {
-            if (xhr.readyState === XMLHttpRequest.DONE) {
-                if (xhr.responseText === "") text = "";
-                else text = MarkdownParser.parse(xhr.responseText);
-            }
-        }
-        xhr.send()
+    MarkdownRenderer {
+        id: renderer
+        style: MarkdownParser.style
     }
 }
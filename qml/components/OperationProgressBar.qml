@@ -0,0 +1,55 @@
+import QtQuick 2.0
+import Sailfish.Silica 1.0
+import org.chum 1.0
+
+Column {
+    readonly property OperationProgress progress: Chum.progress
+
+    function formatSpeed(bytes) {
+        //% "%1 kB/s"
+        return qsTrId("chum-progress-speed").arg(Math.round(bytes / 1024))
+    }
+
+    function formatRemaining(seconds) {
+        //% "%1 min left"
+        return seconds >= 60 ? qsTrId("chum-progress-remaining-min").arg(Math.ceil(seconds / 60))
+                               //% "%1 s left"
+                             : qsTrId("chum-progress-remaining-sec").arg(seconds)
+    }
+
+    visible: progress.active
+    width: parent.width
+
+    ProgressBar {
+        width: parent.width
+        minimumValue: 0
+        maximumValue: 100
+        value: progress.percentage >= 0 ? progress.percentage : 0
+        valueText: progress.percentage >= 0 ? progress.percentage + "%" : ""
+        label: {
+            if (!progress.packageName)
+                return progress.statusText
+            // progress of the package processed now, if known
+            return progress.packagePercentage >= 0
+                    ? progress.statusText + " " + progress.packageName + " (" + progress.packagePercentage + "%)"
+                    : progress.statusText + " " + progress.packageName
+        }
+    }
+
+    Label {
+        anchors.horizontalCenter: parent.horizontalCenter
+        color: Theme.secondaryHighlightColor
+        font.pixelSize: Theme.fontSizeExtraSmall
+        text: {
+            var parts = []
+            if (progress.speed > 0)
+                parts.push(formatSpeed(progress.speed))
+            if (progress.downloadSizeRemaining > 0)
+                parts.push(Format.formatFileSize(progress.downloadSizeRemaining))
+            if (progress.remainingTime > 0)
+                parts.push(formatRemaining(progress.remainingTime))
+            return parts.join(" · ")
+        }
+        visible: text
+    }
+}
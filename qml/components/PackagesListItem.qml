@@ -20,7 +20,9 @@ Item {
         anchors.leftMargin: Theme.horizontalPageMargin
         anchors.verticalCenter: item.verticalCenter
         fillMode: Image.PreserveAspectFit
-        source: model.packageIcon
+        source: model.packageIcon ? "image://chum/" + encodeURIComponent(model.packageIcon) : ""
+        sourceSize.height: Theme.iconSizeLarge
+        sourceSize.width: Theme.iconSizeLarge
         height: Theme.iconSizeLarge
         width: Theme.iconSizeLarge
     }
@@ -14,7 +14,9 @@ Row {
             width: screenshotBox.width / 3
             height: width
             fillMode: Image.PreserveAspectCrop
-            source: screenshots[index]
+            source: "image://chum/" + encodeURIComponent(screenshots[index])
+            sourceSize.height: height
+            sourceSize.width: width
 
             BusyIndicator {
                 anchors.centerIn: parent
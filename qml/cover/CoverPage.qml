@@ -25,4 +25,18 @@ CoverBackground {
                   qsTrId("chum-busy") :
                   ""
     }
+
+    Label {
+        anchors.horizontalCenter: parent.horizontalCenter
+        anchors.top: label.bottom
+        anchors.topMargin: Theme.paddingSmall
+        color: Theme.highlightColor
+        font.pixelSize: Theme.fontSizeSmall
+        horizontalAlignment: Text.AlignHCenter
+        text: Chum.updatesCount > 0 ?
+                  qsTrId("chum-updates-available", Chum.updatesCount) :
+                  ""
+        width: parent.width - 2*Theme.paddingMedium
+        wrapMode: Text.WordWrap
+    }
 }
@@ -7,7 +7,9 @@ Page {
     property ChumPackage pkg
     property LoadableObject issue
 
-    property ListModel _model: ListModel {}
+    property CommentsModel _model: CommentsModel {
+        discussion: issue.value.discussion
+    }
     property int commentsCount: issue.value.commentsCount ? issue.value.commentsCount : 0
     property string number: issue.value.number ? issue.value.number : ""
     property string title: issue.value.title ? issue.value.title : ""
@@ -135,34 +137,13 @@ Page {
                         rightMargin: Theme.horizontalPageMargin
                     }
                     color: Theme.primaryColor
-                    text: model.body
+                    // poor-man's replaceAll() method for styling links
+                    text: model.body.split("<a ").join("<a style='color:%1;' ".arg(Theme.secondaryHighlightColor))
                     textFormat: Text.RichText
                     wrapMode: Text.WordWrap
                     onLinkActivated: Qt.openUrlExternally(link)
                 }
             }
         }
-
-
-    }
-
-    Connections {
-        target: issue
-        onValueChanged: update()
-    }
-
-    Component.onCompleted: update()
-
-    function update() {
-        _model.clear();
-        if (issue.value && issue.value["discussion"])
-            issue.value["discussion"].forEach(function (e) {
-                var tmp = e;
-                const plain  = "<a "
-                const styled = "<a style='color:%1;' ".arg(Theme.secondaryHighlightColor)
-                // poor-man's replaceAll() method:
-                tmp.body = e.body.split(plain).join(styled)
-                _model.append(tmp);
-            });
     }
 }
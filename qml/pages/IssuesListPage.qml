@@ -5,9 +5,7 @@ import "../components"
 
 Page {
     property ChumPackage pkg
-    property LoadableObject issues
-
-    property ListModel _model: ListModel {}
+    property PagedModel issues
 
     id: page
     allowedOrientations: Orientation.All
@@ -28,7 +26,7 @@ Page {
             description: qsTrId("chum-issues")
         }
 
-        model: _model
+        model: issues
         delegate: ListItem {
             id: litem
             contentHeight: content.height + Theme.paddingLarge
@@ -112,21 +110,18 @@ Page {
             }
         }
 
+        footer: Item {
+            width: parent.width
+            height: issues.ready && issues.loading ? footerBusy.height + 2*Theme.paddingLarge : 0
 
-    }
-
-    Connections {
-        target: issues
-        onValueChanged: update()
-    }
-
-    Component.onCompleted: update()
+            BusyIndicator {
+                id: footerBusy
+                anchors.centerIn: parent
+                running: issues.ready && issues.loading
+                size: BusyIndicatorSize.Medium
+            }
+        }
 
-    function update() {
-        _model.clear();
-        if (issues.value && issues.value["issues"])
-            issues.value["issues"].forEach(function (e) {
-                _model.append(e);
-            });
+        VerticalScrollDecorator {}
     }
 }
@@ -10,6 +10,12 @@ Page {
     id: page
     allowedOrientations: Orientation.All
 
+    Component.onCompleted: {
+        pkg.viewOpened()
+        pkg.loadProject()
+    }
+    Component.onDestruction: if (pkg) pkg.viewClosed()
+
     SilicaFlickable {
         anchors.fill: parent
         contentHeight: content.height + Theme.paddingLarge
@@ -82,10 +88,12 @@ Page {
                 title: pkg.name
                 author: pkg.packager ? pkg.packager : pkg.developer
                 description: pkg.summary
-                iconSource: pkg.icon
+                iconSource: pkg.icon ? "image://chum/" + encodeURIComponent(pkg.icon) : ""
                 packagerShown: pkg.packager
             }
 
+            OperationProgressBar { }
+
             AppSummary {
                 pkg: page.pkg
             }
@@ -34,6 +34,8 @@ Page {
                                             qsTrId("chum-packages")
             }
 
+            OperationProgressBar { }
+
             SearchField {
                 id: searchField
                 text: page.search
@@ -85,6 +87,8 @@ Page {
                 page.removeSearchFocus();
             }
 
+            Component.onCompleted: chumModel.fetch(index)
+
             PackagesListItem {
                 id: item
                 highlighted: lItem.highlighted
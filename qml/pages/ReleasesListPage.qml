@@ -5,9 +5,7 @@ import "../components"
 
 Page {
     property ChumPackage pkg
-    property LoadableObject releases
-
-    property ListModel _model: ListModel {}
+    property PagedModel releases
 
     id: page
     allowedOrientations: Orientation.All
@@ -28,7 +26,7 @@ Page {
             description: qsTrId("chum-releases")
         }
 
-        model: _model
+        model: releases
         delegate: ListItem {
             id: litem
             contentHeight: content.height + Theme.paddingLarge
@@ -72,21 +70,18 @@ Page {
             }
         }
 
+        footer: Item {
+            width: parent.width
+            height: releases.ready && releases.loading ? footerBusy.height + 2*Theme.paddingLarge : 0
 
-    }
-
-    Connections {
-        target: releases
-        onValueChanged: update()
-    }
-
-    Component.onCompleted: update()
+            BusyIndicator {
+                id: footerBusy
+                anchors.centerIn: parent
+                running: releases.ready && releases.loading
+                size: BusyIndicatorSize.Medium
+            }
+        }
 
-    function update() {
-        _model.clear();
-        if (releases.value && releases.value["releases"])
-            releases.value["releases"].forEach(function (e) {
-                _model.append(e);
-            });
+        VerticalScrollDecorator {}
     }
 }
@@ -26,7 +26,9 @@ FullscreenContentPage {
             Image {
                 id: image
                 anchors.fill: parent
-                source: screenshots[index]
+                source: "image://chum/" + encodeURIComponent(screenshots[index])
+                sourceSize.height: Screen.height
+                sourceSize.width: Screen.height
                 fillMode: Image.PreserveAspectFit
                 opacity: status === Image.Ready ? 1.0 : 0.0
 
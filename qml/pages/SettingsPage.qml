@@ -62,6 +62,14 @@ Page {
                 wrapMode: Text.WordWrap
             }
 
+            Button {
+                anchors.horizontalCenter: parent.horizontalCenter
+                visible: Chum.repoChanging
+                //% "Cancel repository change"
+                text: qsTrId("chum-settings-cancel-repo-change")
+                onClicked: Chum.cancelRepoChange()
+            }
+
             SectionHeader {
                 //% "General settings"
                 text: qsTrId("chum-settings-general")
@@ -78,6 +86,33 @@ Page {
                 onClicked: Chum.showAppsByDefault = !Chum.showAppsByDefault
             }
 
+            ComboBox {
+                currentIndex: Chum.performanceProfile
+                description: Chum.lowEndProfile ?
+                                 //% "Fewer package details are loaded at once, images are decoded at reduced size, "
+                                 //% "caches are smaller and search starts after typing pauses."
+                                 qsTrId("chum-settings-performance-lowend-description") :
+                                 //% "All optimizations for devices with limited memory and CPU are disabled."
+                                 qsTrId("chum-settings-performance-standard-description")
+                //% "Performance profile"
+                label: qsTrId("chum-settings-performance")
+                menu: ContextMenu {
+                    MenuItem {
+                        //% "Automatic"
+                        text: qsTrId("chum-settings-performance-auto")
+                    }
+                    MenuItem {
+                        //% "Standard"
+                        text: qsTrId("chum-settings-performance-standard")
+                    }
+                    MenuItem {
+                        //% "Low-end device"
+                        text: qsTrId("chum-settings-performance-lowend")
+                    }
+                }
+                onCurrentIndexChanged: Chum.performanceProfile = currentIndex
+            }
+
             SectionHeader {
                 //% "Advanced settings"
                 text: qsTrId("chum-settings-advanced")
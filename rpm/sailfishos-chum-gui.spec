@@ -125,6 +125,10 @@ cp -a %{_libdir}/libyaml-cpp.so.* %{buildroot}%{_datadir}/%{name}/lib
 chmod -x %{buildroot}%{_datadir}/%{name}/lib/*.so*
 %endif
 
+# Enable the periodic update check for all users
+mkdir -p %{buildroot}%{_prefix}/lib/systemd/user/timers.target.wants
+ln -s ../%{name}-update-check.timer %{buildroot}%{_prefix}/lib/systemd/user/timers.target.wants/
+
 # Rectify desktop file for older SFOS version targets < v4.1.0
 %if %{defined sailfishos_version} && 0%{?sailfishos_version} < 40100
 sed -i 's/silica-qt5/generic/' %{buildroot}%{_datadir}/applications/%{name}.desktop
@@ -163,3 +167,6 @@ exit 0
 %{_datadir}/applications/%{name}.desktop
 %{_datadir}/icons/hicolor/*/apps/%{name}.png
 %{_datadir}/mapplauncherd/privileges.d/%{name}
+%{_prefix}/lib/systemd/user/%{name}-update-check.service
+%{_prefix}/lib/systemd/user/%{name}-update-check.timer
+%{_prefix}/lib/systemd/user/timers.target.wants/%{name}-update-check.timer
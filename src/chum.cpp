@@ -1,9 +1,34 @@
 #include "chum.h"
+#include "detailscache.h"
+#include "forgereply.h"
+#include "imageprovider.h"
+#include "networkmanager.h"
+#include "performanceprofile.h"
+#include "stallwatchdog.h"
+#include "tracer.h"
+#include "updatechecker.h"
 
 #include <PackageKit/Daemon>
 
+#include "main.h"
+
+#include <QDBusConnection>
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include <QNetworkRequest>
 #include <QSettings>
+#include <QSaveFile>
+#include <QSharedPointer>
+#include <QStandardPaths>
+#include <QUrl>
 
 using namespace PackageKit;
 
@@ -11,6 +36,13 @@ Chum* Chum::s_instance{nullptr};
 
 static QString s_config_showapps{QStringLiteral("main/showAppsByDefault")};
 static QString s_config_manualversion{QStringLiteral("main/manualVersion")};
+static QString s_config_repo_url{QStringLiteral("repository/url")};
+static QString s_config_repo_refreshed{QStringLiteral("repository/lastRefresh")};
+static QString s_config_repo_revision{QStringLiteral("repository/revision")};
+static QString s_config_repo_ttl{QStringLiteral("repository/refreshTtlMinutes")};
+
+// Repository metadata younger than this is used without forcing a refresh on startup
+static const int s_repo_ttl_default{6*60};
 
 static inline auto role2operation(Transaction::Role role) {
     switch (role) {
@@ -31,11 +63,37 @@ Chum::Chum(QObject *parent)
 {
     connect(&m_ssu, &Ssu::updated, this, &Chum::repositoriesListUpdated);
     connect(&m_ssu, &Ssu::updated, this, &Chum::repoUpdated);
+    connect(&m_ssu, &Ssu::stepChanged, this, &Chum::repositoriesStepChanged);
+    connect(&m_ssu, &Ssu::cancelled, this, &Chum::repositoriesChangeAborted);
+    connect(&m_ssu, &Ssu::failed, this, [this](const QString &details) {
+        qWarning() << "Failed to change SailfishOS:Chum repository" << details;
+        //% "Failed to change SailfishOS:Chum repository!"
+        emit this->error(qtTrId("chum-repo-change-failed"));
+        this->repositoriesChangeAborted();
+    });
     connect(Daemon::global(), &Daemon::updatesChanged, this, [this]() { this->getUpdates(); });
 
+    m_progress = new OperationProgress(this);
+
+    // Trim caches when moved to background or when memory is low
+    if (auto app = qobject_cast<QGuiApplication*>(QCoreApplication::instance()))
+        connect(app, &QGuiApplication::applicationStateChanged, this, &Chum::applicationStateChanged);
+    QDBusConnection::systemBus().connect(QStringLiteral("com.nokia.mce"),
+                                         QStringLiteral("/com/nokia/mce/signal"),
+                                         QStringLiteral("com.nokia.mce.signal"),
+                                         QStringLiteral("sig_memory_level_ind"),
+                                         this, SLOT(memoryLevelChanged(QString)));
+
     QSettings settings;
     m_show_apps_by_default = (settings.value(s_config_showapps, 1).toInt() != 0);
     m_manualVersion = (settings.value(s_config_manualversion, QString()).toString());
+    m_ssu.setVersion(m_manualVersion);
+
+    // Verify locally found updates against PackageKit
+    m_verify_updates = !qgetenv("CHUM_VERIFY_UPDATES").isEmpty();
+
+    // Number of updates as found by the last check, until the refresh is finished
+    m_updates_count = UpdateChecker::readState().value(QStringLiteral("count"), 0).toUInt();
 
     m_busy = true;
     //% "Loading SailfishOS:Chum repository"
@@ -48,10 +106,126 @@ Chum* Chum::instance() {
     return s_instance;
 }
 
-QString Chum::packageId(const QString &pkg_id)
+QString Chum::packageId(const PackageId &pkid) const
 {
     // Use the name of a package as its package ID to ensure that only a single copy of each package is handled
-    return Daemon::packageName(pkg_id);
+    return pkid.name();
+}
+
+// Record a stage of the refresh pipeline, its requested and returned item
+// counts and the PackageKit transaction runtime, if tracing is enabled
+void Chum::traceStage(Transaction *pktr, const QString &stage, int items) {
+    Tracer *tracer = Tracer::instance();
+    if (!tracer->enabled()) return;
+
+    const qint64 start = tracer->now();
+    auto results = QSharedPointer<int>::create(0);
+    connect(pktr, &Transaction::package, this, [results]() { ++(*results); });
+    connect(pktr, &Transaction::details, this, [results]() { ++(*results); });
+    connect(pktr, &Transaction::finished, this,
+            [tracer, stage, items, start, results](Transaction::Exit status, uint runtime) {
+        tracer->complete(stage, QStringLiteral("refresh"), start, {
+                             {QStringLiteral("items"), items},
+                             {QStringLiteral("results"), *results},
+                             {QStringLiteral("runtime_ms"), runtime},
+                             {QStringLiteral("exit"), int(status)}
+                         });
+    });
+}
+
+// Requests, received bytes and errors per host
+QVariantMap Chum::networkStatistics() const {
+    return NetworkManager::statistics();
+}
+
+// Latency histograms and outcomes of forge requests per backend and host
+QVariantMap Chum::forgeStatistics() const {
+    return ForgeReply::statistics();
+}
+
+QVariantMap Chum::detailsCacheStatistics() const {
+    return DetailsCache::instance()->statistics();
+}
+
+QVariantMap Chum::memoryStatistics() const {
+    ChumPackage::MemoryUsage usage;
+    for (const ChumPackage *p: m_packages)
+        p->addMemoryUsage(usage);
+
+    const QVariantMap process = Tracer::memoryUsage();
+    return QVariantMap{
+        {QStringLiteral("packages"), m_packages.size()},
+        {QStringLiteral("packageMetadataBytes"), usage.metadata},
+        {QStringLiteral("descriptionsBytes"), usage.descriptions},
+        {QStringLiteral("loadableObjects"), usage.objects_count},
+        {QStringLiteral("loadableObjectsBytes"), usage.objects},
+        {QStringLiteral("projects"), usage.projects_count},
+        {QStringLiteral("detailsCacheBytes"), DetailsCache::instance()->bytes()},
+        {QStringLiteral("processRssKb"), process.value(QStringLiteral("rss_kb"))},
+        {QStringLiteral("processPeakRssKb"), process.value(QStringLiteral("peak_rss_kb"))}
+    };
+}
+
+QVariantMap Chum::trimStatistics() const {
+    QVariantMap result = ChumPackage::trimStatistics();
+    result.insert(QStringLiteral("trims"), m_trim_count);
+    result.insert(QStringLiteral("trimmedBytes"), m_trimmed_bytes);
+    result.insert(QStringLiteral("lastTrimmedBytes"), m_last_trimmed_bytes);
+    result.insert(QStringLiteral("background"), m_background);
+    return result;
+}
+
+bool Chum::lowEndProfile() const {
+    return PerformanceProfile::instance()->lowEnd();
+}
+
+int Chum::performanceProfile() const {
+    return PerformanceProfile::instance()->mode();
+}
+
+// Event loop latency and the sections causing stalls
+QVariantMap Chum::stallStatistics() const {
+    return StallWatchdog::instance()->statistics();
+}
+
+// All statistics collected for diagnostics of field issues
+QVariantMap Chum::diagnostics() const {
+    return QVariantMap{
+        {QStringLiteral("version"), QCoreApplication::applicationVersion()},
+        {QStringLiteral("lowEndProfile"), lowEndProfile()},
+        {QStringLiteral("stalls"), stallStatistics()},
+        {QStringLiteral("network"), networkStatistics()},
+        {QStringLiteral("forge"), forgeStatistics()},
+        {QStringLiteral("detailsCache"), detailsCacheStatistics()},
+        {QStringLiteral("memory"), memoryStatistics()},
+        {QStringLiteral("trim"), trimStatistics()}
+    };
+}
+
+bool Chum::saveDiagnostics(const QString &filename) const {
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write diagnostics to" << filename << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(QJsonObject::fromVariantMap(diagnostics())).toJson());
+    return file.commit();
+}
+
+void Chum::setPerformanceProfile(int mode) {
+    PerformanceProfile *profile = PerformanceProfile::instance();
+    if (mode < PerformanceProfile::Auto || mode > PerformanceProfile::LowEnd ||
+            profile->mode() == mode)
+        return;
+    profile->setMode(PerformanceProfile::Mode(mode));
+
+    // apply limits of the caches, others are read when used
+    DetailsCache::instance()->setMaxBytes(profile->detailsCacheBytes());
+    if (ImageProvider *provider = ImageProvider::instance()) {
+        provider->setMemoryCacheKb(profile->imageCacheKb());
+        provider->setDiskCacheBytes(profile->imageDiskCacheBytes());
+    }
+    emit performanceProfileChanged();
 }
 
 void Chum::setShowAppsByDefault(bool v) {
@@ -69,16 +243,69 @@ void Chum::setManualVersion(const QString &v) {
     }
 
     if (m_manualVersion == v) return;
+    const QString previous = m_manualVersion;
     m_manualVersion = v.trimmed();
 
+    if (!startRepoChange(qtTrId("chum-add-testing-repo"), m_ssu.repoTesting())) {
+        m_manualVersion = previous;
+        return;
+    }
+    m_manualVersion_previous = previous;
+
     QSettings settings;
     settings.setValue(s_config_manualversion, v);
     emit manualVersionChanged();
+}
 
-    m_busy = true;
-    emit busyChanged();
-    setStatus(qtTrId("chum-add-testing-repo"));
-    m_ssu.setRepo(m_manualVersion, m_ssu.repoTesting());
+//////////////////////////////////////////////////////
+/// Cache trimming
+
+// In background, forge requests for list entries are paused and caches
+// which are cheap to restore are cleared. On memory pressure, loaded
+// issues and releases of packages which are not shown are dropped and
+// descriptions are compressed as well.
+void Chum::applicationStateChanged(Qt::ApplicationState state) {
+    const bool background = state != Qt::ApplicationActive;
+    if (background == m_background) return;
+    m_background = background;
+    ChumPackage::setHydrationPaused(background);
+    if (background) {
+        // latency in background is not seen by the user
+        StallWatchdog::instance()->stop();
+        trimCaches(false);
+    } else
+        StallWatchdog::instance()->start();
+}
+
+void Chum::memoryLevelChanged(const QString &level) {
+    if (level == QLatin1String("warning") || level == QLatin1String("critical"))
+        trimCaches(true);
+}
+
+void Chum::trimCaches(bool memory_pressure) {
+    const qint64 trace_start = Tracer::instance()->now();
+    qint64 images = 0;
+    if (ImageProvider *provider = ImageProvider::instance()) {
+        images = provider->memoryCacheBytes();
+        provider->clearMemoryCache();
+    }
+    const qint64 details = DetailsCache::instance()->bytes();
+    DetailsCache::instance()->clear();
+
+    qint64 packages = 0;
+    if (memory_pressure)
+        for (ChumPackage *p: m_packages)
+            packages += p->trim();
+
+    m_last_trimmed_bytes = images + details + packages;
+    m_trimmed_bytes += m_last_trimmed_bytes;
+    ++m_trim_count;
+    Tracer::instance()->complete(QStringLiteral("trimCaches"), QStringLiteral("memory"), trace_start, {
+                                     {QStringLiteral("memory_pressure"), memory_pressure},
+                                     {QStringLiteral("images_bytes"), images},
+                                     {QStringLiteral("details_bytes"), details},
+                                     {QStringLiteral("packages_bytes"), packages}
+                                 });
 }
 
 /////////////////////////////////////////////////////////////
@@ -90,16 +317,24 @@ void Chum::setManualVersion(const QString &v) {
 ///
 /// At the end of the update sequence, packagesChanged() is emitted.
 ///
+/// Package operations requested while the sequence is running preempt
+/// it: the current transaction is cancelled, if possible, and the
+/// operation is started at the next boundary between the stages. The
+/// sequence is restarted after the operation.
+///
 void Chum::refreshPackages() {
     if (!m_busy) {
         m_busy = true;
         emit busyChanged();
     }
+    m_refreshing = true;
 
     m_packages_last_refresh.clear();
     m_packages_last_refresh_installed.clear();
 
     auto pktr = Daemon::getPackages(Transaction::FilterNotSource);
+    m_refresh_transaction = pktr;
+    traceStage(pktr, QStringLiteral("refreshPackages"), 0);
     //% "Retrieving list of available packages"
     setStatus(qtTrId("chum-get-list-packages"));
     connect(pktr, &Transaction::package,  this, [this](
@@ -107,44 +342,92 @@ void Chum::refreshPackages() {
             const QString &packageID,
             [[maybe_unused]] const QString &summary
             ) {
-        QString pn = Daemon::packageName(packageID);
+        const PackageId pkid(packageID);
+        const QString pn = pkid.name();
         if (pn.endsWith(QLatin1String("-debuginfo")) ||
                 pn.endsWith(QLatin1String("-debugsource")) )
             return;
-        QString pd = Daemon::packageData(packageID);
+        const QString pd = pkid.data();
         if (pd == m_ssu.repoName())
-            m_packages_last_refresh.insert(packageID);
-        else if (pd == QStringLiteral("installed"))
-            m_packages_last_refresh_installed.insert(packageID);
+            m_packages_last_refresh.insert(pkid);
+        else if (pd == QLatin1String("installed"))
+            m_packages_last_refresh_installed.insert(pkid);
+    });
+    connect(pktr, &Transaction::finished, this, [this]() {
+        if (!this->refreshPreempted())
+            this->refreshPackagesInstalled();
     });
-    connect(pktr, &Transaction::finished, this, &Chum::refreshPackagesInstalled);
 }
 
 void Chum::refreshPackagesInstalled()
 {
-    // Check which repository provides the installed packages
-    QHash<QString,QString> packages;
-    for (const auto &p: m_packages_last_refresh_installed)
-        packages[p] = Daemon::packageName(p);
+    // Installed packages are listed by getPackages without the
+    // repository that provides them. Packages from Chum repository which
+    // are installed in the available version are not listed separately.
+    // The providing repository is checked only for installed packages
+    // which are in the catalog of the previous refresh or were not
+    // checked before: the catalog also records the installed packages
+    // found to be provided by other repositories, by their name, version
+    // and architecture, so that a package is checked again after it was
+    // installed, updated or replaced outside of this application.
+    QSet<QString> available_names;
+    for (const PackageId &p: m_packages_last_refresh)
+        available_names.insert(p.name());
+
+    QSet<QString> catalog;
+    QSet<QString> others;
+    readCatalog(catalog, others);
+    m_catalog_others.clear();
+    auto candidates = QSharedPointer<QHash<QString, QString>>::create(); // name -> others key
+    for (const PackageId &p: m_packages_last_refresh_installed) {
+        const QString name = p.name();
+        if (available_names.contains(name)) continue;
+        const QString key = name + QLatin1Char(';') + p.version() + QLatin1Char(';') + p.arch();
+        if (others.contains(key) && !catalog.contains(name))
+            m_catalog_others.insert(key);
+        else
+            candidates->insert(name, key);
+    }
 
-    auto tr = Daemon::whatProvides(packages.values());
-    connect(tr, &Transaction::package, this, [this](
+    if (candidates->isEmpty()) {
+        // no PackageKit transaction needed
+        refreshPackagesFinished();
+        return;
+    }
+
+    auto provided = QSharedPointer<QSet<QString>>::create();
+    auto tr = Daemon::whatProvides(candidates->keys());
+    m_refresh_transaction = tr;
+    traceStage(tr, QStringLiteral("refreshPackagesInstalled"), candidates->size());
+    connect(tr, &Transaction::package, this, [this, provided](
             [[maybe_unused]] int info,
             const QString &packageID,
             [[maybe_unused]] const QString &summary
             ) {
-        QString pd = Daemon::packageData(packageID);
-        if (pd == m_ssu.repoName())
-            m_packages_last_refresh.insert(packageID);
+        const PackageId pkid(packageID);
+        if (pkid.data() == m_ssu.repoName()) {
+            m_packages_last_refresh.insert(pkid);
+            provided->insert(pkid.name());
+        }
+    });
+    connect(tr, &Transaction::finished, this, [this, candidates, provided](Transaction::Exit status) {
+        if (status == Transaction::ExitSuccess)
+            for (auto i = candidates->cbegin(); i != candidates->cend(); ++i)
+                if (!provided->contains(i.key()))
+                    m_catalog_others.insert(i.value());
+        if (!this->refreshPreempted())
+            this->refreshPackagesFinished();
     });
-    connect(tr, &Transaction::finished, this, &Chum::refreshPackagesFinished);
 }
 
 void Chum::refreshPackagesFinished()
 {
+    StallWatchdog::Section section("refreshPackagesFinished");
+    const qint64 trace_start = Tracer::instance()->now();
+
     // Check if some packages are not offered anymore
     QSet<QString> last_ids;
-    for (const QString &p: m_packages_last_refresh)
+    for (const PackageId &p: m_packages_last_refresh)
         last_ids.insert(packageId(p));
 
     // Remove packages from local list, which are not offered anymore
@@ -157,7 +440,7 @@ void Chum::refreshPackagesFinished()
         }
 
     // Create or update package entries on the local list
-    for (const QString &p: m_packages_last_refresh) {
+    for (const PackageId &p: m_packages_last_refresh) {
         const QString id = packageId(p);
         ChumPackage *package = m_packages.value(id, nullptr);
         if (!package) {
@@ -167,10 +450,60 @@ void Chum::refreshPackagesFinished()
         package->setPkidLatest(p);
     }
 
+    Tracer::instance()->complete(QStringLiteral("refreshPackagesFinished"),
+                                 QStringLiteral("refresh"), trace_start,
+                                 {{QStringLiteral("items"), m_packages.size()}});
+
+    saveCatalog();
+
     setStatus(QLatin1String(""));
     refreshDetails();
 }
 
+static QString catalogFileName() {
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+            QStringLiteral("/sailfishos-chum-gui/catalog.json");
+}
+
+// names of packages offered by the current repository at the last
+// refresh and installed packages provided by other repositories
+void Chum::readCatalog(QSet<QString> &names, QSet<QString> &others) const {
+    StallWatchdog::Section section("catalog json");
+    QFile file(catalogFileName());
+    if (!file.open(QIODevice::ReadOnly)) return;
+    const QJsonObject json = QJsonDocument::fromJson(file.readAll()).object();
+    if (json.value(QStringLiteral("repo")).toString() != m_ssu.repoName())
+        return;
+    for (const QJsonValue &v: json.value(QStringLiteral("names")).toArray())
+        names.insert(v.toString());
+    for (const QJsonValue &v: json.value(QStringLiteral("others")).toArray())
+        others.insert(v.toString());
+}
+
+void Chum::saveCatalog() const {
+    StallWatchdog::Section section("catalog json");
+    QJsonArray names;
+    for (const ChumPackage *p: m_packages)
+        names.append(p->pkidLatest().name());
+    QJsonArray others;
+    for (const QString &o: m_catalog_others)
+        others.append(o);
+    QJsonObject json;
+    json.insert(QStringLiteral("repo"), m_ssu.repoName());
+    json.insert(QStringLiteral("names"), names);
+    json.insert(QStringLiteral("others"), others);
+
+    const QString filename = catalogFileName();
+    QDir().mkpath(QFileInfo(filename).absolutePath());
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write package catalog to" << filename;
+        return;
+    }
+    file.write(QJsonDocument(json).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
 void Chum::refreshDetails() {
     if (!m_busy) {
         m_busy = true;
@@ -183,21 +516,25 @@ void Chum::refreshDetails() {
     QStringList packages;
     for (const ChumPackage *p: m_packages)
         if (p->detailsNeedsUpdate())
-            packages.append(p->pkidLatest());
+            packages.append(p->pkidLatest().toString());
 
     auto tr = Daemon::getDetails(packages);
+    m_refresh_transaction = tr;
+    traceStage(tr, QStringLiteral("refreshDetails"), packages.size());
     connect(tr, &Transaction::details, this, [this](const auto &v) {
-        const QString pkid = v.packageId();
+        StallWatchdog::Section section("refreshDetails");
+        const PackageId pkid(v.packageId());
         ChumPackage *p = m_packages.value(this->packageId(pkid), nullptr);
         if (p)
             p->setDetails(v);
         else
-            qWarning() << "Found detail infomation of currently unavailable package:" << pkid;
+            qWarning() << "Found detail infomation of currently unavailable package:" << pkid.toString();
     });
 
     connect(tr, &Transaction::finished, this, [this]() {
         setStatus(QLatin1String(""));
-        this->refreshInstalledVersion();
+        if (!this->refreshPreempted())
+            this->refreshInstalledVersion();
     });
 }
 
@@ -211,41 +548,143 @@ void Chum::refreshInstalledVersion() {
     setStatus(qtTrId("chum-get-package-version"));
 
     QStringList packages;
-    for (ChumPackage *p: m_packages) {
-        p->clearInstalled();
-        packages.append(Daemon::packageName(p->pkidLatest()));
-    }
+    for (ChumPackage *p: m_packages)
+        packages.append(p->pkidLatest().name());
 
+    auto found = QSharedPointer<QSet<QString>>::create();
     auto tr = Daemon::resolve(packages, Transaction::FilterInstalled);
-    connect(tr, &Transaction::package, this, [this](
+    m_refresh_transaction = tr;
+    traceStage(tr, QStringLiteral("refreshInstalledVersion"), packages.size());
+    connect(tr, &Transaction::package, this, [this, found](
             [[maybe_unused]] auto info,
             const auto &packageID,
             [[maybe_unused]] const auto &summary) {
-        ChumPackage *p = m_packages.value(this->packageId(packageID), nullptr);
-        if (p) p->setPkidInstalled(packageID);
-        else
+        const PackageId pkid(packageID);
+        const QString id = this->packageId(pkid);
+        ChumPackage *p = m_packages.value(id, nullptr);
+        if (p) {
+            p->setPkidInstalled(pkid);
+            found->insert(id);
+        } else
             qWarning() << "Found an installed package, which is currently not available:" << packageID;
     });
 
-    connect(tr, &Transaction::finished, this, [this]() {
-        size_t new_count = 0;
-        for (ChumPackage *p: m_packages)
-            if (p->installed())
-                ++new_count;
-        if (m_installed_count != new_count) {
-            m_installed_count = new_count;
-            emit this->installedCountChanged();
+    connect(tr, &Transaction::finished, this, [this, found](Transaction::Exit status) {
+        StallWatchdog::Section section("refreshInstalledVersion");
+        // Packages are marked as not installed only after a complete
+        // resolve, a preempted stage keeps the previous state
+        if (status == Transaction::ExitSuccess)
+            for (ChumPackage *p: m_packages)
+                if (!found->contains(p->id()))
+                    p->clearInstalled();
+        this->updateInstalledCount();
+        this->setStatus(QLatin1String(""));
+        if (!this->refreshPreempted())
+            this->getUpdates(true);
+    });
+}
+
+/// Targeted alternative to the full refresh sequence, used after
+/// package operations. Only the packages with the given names are
+/// resolved and their state is patched in place. The full sequence
+/// is kept for explicit repository refreshes.
+void Chum::refreshPackagesState(const QSet<QString> &names) {
+    if (!m_busy) {
+        m_busy = true;
+        emit busyChanged();
+    }
+
+    QStringList packages;
+    for (const QString &name: names)
+        if (m_packages.contains(name))
+            packages.append(name);
+
+    if (packages.isEmpty()) {
+        m_busy = false;
+        emit busyChanged();
+        continueQueued();
+        return;
+    }
+
+    //% "Retrieving the currently available versions of installed packages"
+    setStatus(qtTrId("chum-get-package-version"));
+
+    auto found = QSharedPointer<QSet<QString>>::create();
+    auto tr = Daemon::resolve(packages, Transaction::FilterInstalled);
+    traceStage(tr, QStringLiteral("refreshPackagesState"), packages.size());
+    connect(tr, &Transaction::package, this, [this, found](
+            [[maybe_unused]] auto info,
+            const auto &packageID,
+            [[maybe_unused]] const auto &summary) {
+        const PackageId pkid(packageID);
+        const QString id = this->packageId(pkid);
+        ChumPackage *p = m_packages.value(id, nullptr);
+        if (!p) return;
+        p->setPkidInstalled(pkid);
+        found->insert(id);
+    });
+
+    connect(tr, &Transaction::finished, this, [this, packages, found]() {
+        StallWatchdog::Section section("refreshPackagesState");
+        for (const QString &id: packages) {
+            ChumPackage *p = m_packages.value(id, nullptr);
+            if (!p) continue;
+            if (!found->contains(id))
+                p->clearInstalled();
+            p->setUpdateAvailable(p->newerVersionAvailable());
         }
+        this->updateInstalledCount();
+        this->updateUpdatesCount();
+        this->saveUpdatesState();
         this->setStatus(QLatin1String(""));
-        this->getUpdates(true);
+        m_busy = false;
+        emit this->busyChanged();
+        emit this->packagesChanged();
+        this->continueQueued();
     });
 }
 
+void Chum::updateInstalledCount() {
+    quint32 new_count = 0;
+    for (ChumPackage *p: m_packages)
+        if (p->installed())
+            ++new_count;
+    if (m_installed_count != new_count) {
+        m_installed_count = new_count;
+        emit installedCountChanged();
+    }
+}
+
+void Chum::saveUpdatesState() {
+    QStringList updates;
+    for (ChumPackage *p: m_packages)
+        if (p->updateAvailable())
+            updates.append(p->id());
+    UpdateChecker::writeState(m_ssu.repoName(), updates);
+}
+
+void Chum::updateUpdatesCount() {
+    quint32 new_count = 0;
+    for (ChumPackage *p: m_packages)
+        if (p->updateAvailable())
+            ++new_count;
+    if (m_updates_count != new_count) {
+        m_updates_count = new_count;
+        emit updatesCountChanged();
+    }
+}
+
 /// This is the last method in the sequence of methods used to update
 /// the metadata of packages. It can be called as a Qt-"slot" for the
 /// packagekit signal. The flag `force` is used to distinguish
 /// whether the call was internal (i.e., from this class: force=true)
 /// or as a signal slot (force=false).
+///
+/// Within the sequence, the available updates are found locally by
+/// comparing the latest and the installed versions of the packages.
+/// PackageKit is asked for updates only when it signals that they
+/// changed, as the package IDs known here may be outdated then, or
+/// for verification of the local result if CHUM_VERIFY_UPDATES is set.
 void Chum::getUpdates(bool force) {
     if (m_busy && !force) return;
 
@@ -254,37 +693,90 @@ void Chum::getUpdates(bool force) {
         emit busyChanged();
     }
 
-    //% "Checking for which installed packages an update is available"
-    setStatus(qtTrId("chum-check-updates"));
+    if (!force) {
+        verifyUpdates();
+        return;
+    }
 
+    StallWatchdog::Section section("getUpdates");
+    const qint64 trace_start = Tracer::instance()->now();
     for (ChumPackage *p: m_packages)
-        p->setUpdateAvailable(false);
+        p->setUpdateAvailable(p->newerVersionAvailable());
+    Tracer::instance()->complete(QStringLiteral("getUpdatesLocal"),
+                                 QStringLiteral("refresh"), trace_start,
+                                 {{QStringLiteral("items"), m_packages.size()}});
+
+    if (m_verify_updates)
+        verifyUpdates();
+    else
+        getUpdatesFinished();
+}
+
+// Updates as reported by PackageKit, differences to the local result
+// are logged and PackageKit is followed
+void Chum::verifyUpdates() {
+    //% "Checking for which installed packages an update is available"
+    setStatus(qtTrId("chum-check-updates"));
 
+    auto updates = QSharedPointer<QSet<QString>>::create();
     auto pktr = Daemon::getUpdates();
-    connect(pktr, &Transaction::package, this, [this](
+    if (m_refreshing)
+        m_refresh_transaction = pktr;
+    traceStage(pktr, QStringLiteral("getUpdates"), m_packages.size());
+    connect(pktr, &Transaction::package, this, [this, updates](
             [[maybe_unused]] int info,
             const QString &packageID,
             [[maybe_unused]] const QString &summary
             ) {
-        ChumPackage *p = m_packages.value(this->packageId(packageID), nullptr);
-        if (p) p->setUpdateAvailable(true);
+        const QString id = this->packageId(PackageId(packageID));
+        if (m_packages.contains(id))
+            updates->insert(id);
     });
-    connect(pktr, &Transaction::finished, this, [this]() {
-        size_t new_count = 0;
-        for (ChumPackage *p: m_packages)
-            if (p->updateAvailable())
-                ++new_count;
-        if (m_updates_count != new_count) {
-            m_updates_count = new_count;
-            emit this->updatesCountChanged();
+    connect(pktr, &Transaction::finished, this, [this, updates](Transaction::Exit status) {
+        if (status == Transaction::ExitCancelled) {
+            this->getUpdatesFinished();
+            return;
         }
-        this->setStatus(QLatin1String(""));
-        m_busy = false;
-        emit this->busyChanged();
-        emit this->packagesChanged();
+        for (ChumPackage *p: m_packages) {
+            const bool up = updates->contains(p->id());
+            if (up != p->updateAvailable())
+                qWarning() << "Update availability of" << p->id() << "differs from PackageKit:"
+                           << p->installedVersion() << "installed," << p->pkidLatest().version()
+                           << "available, PackageKit reports" << (up ? "an update" : "no update");
+            p->setUpdateAvailable(up);
+        }
+        this->getUpdatesFinished();
     });
 }
 
+void Chum::getUpdatesFinished() {
+    StallWatchdog::Section section("getUpdatesFinished");
+    updateUpdatesCount();
+    saveUpdatesState();
+    setStatus(QLatin1String(""));
+    m_refreshing = false;
+    m_refresh_transaction.clear();
+    m_busy = false;
+    emit busyChanged();
+    emit packagesChanged();
+
+    // End-to-end time and footprint of a full refresh
+    if (m_trace_refresh_start >= 0) {
+        Tracer *tracer = Tracer::instance();
+        tracer->complete(QStringLiteral("fullRefresh"), QStringLiteral("refresh"),
+                         m_trace_refresh_start, {
+                             {QStringLiteral("packages"), m_packages.size()},
+                             {QStringLiteral("installed"), m_installed_count},
+                             {QStringLiteral("updates"), m_updates_count}
+                         });
+        tracer->counter(QStringLiteral("memory"), Tracer::memoryUsage());
+        m_trace_refresh_start = -1;
+    }
+
+    // operation requested during the last stage, no restart needed
+    continueQueued();
+}
+
 // Refresh repository and update package metadata
 void Chum::refreshRepo(bool force) {
     if (m_busy && !force) return;
@@ -301,20 +793,43 @@ void Chum::refreshRepo(bool force) {
 
     //% "Refreshing SailfishOS:Chum repository"
     setStatus(qtTrId("chum-refresh-repository"));
+    m_trace_refresh_start = Tracer::instance()->now();
+    m_refreshing = true;
+    m_refresh_repo = true;
+
+    // revision of the metadata downloaded by this refresh, unless known
+    // from the freshness check
+    if (m_repo_revision.isEmpty()) {
+        const int serial = ++m_repo_revision_serial;
+        fetchRepoRevision([this, serial](const QString &revision) {
+            if (serial == m_repo_revision_serial)
+                m_repo_revision = revision;
+        });
+    }
 
     auto pktr = Daemon::repoSetData(
                 m_ssu.repoName(),
                 QStringLiteral("refresh-now"),
                 QVariant::fromValue(true).toString()
                 );
+    m_refresh_transaction = pktr;
+    traceStage(pktr, QStringLiteral("refreshRepo"), 1);
     connect(pktr, &Transaction::finished, this, [this](PackageKit::Transaction::Exit status) {
         setStatus(QLatin1String(""));
-        refreshPackages();
-        if (status == PackageKit::Transaction::ExitSuccess)
+        // repository is refreshed again after a cancellation
+        if (status != PackageKit::Transaction::ExitCancelled)
+            m_refresh_repo = false;
+        if (status == PackageKit::Transaction::ExitSuccess) {
+            this->setRepoRefreshed();
             emit this->repositoryRefreshed();
+        }
+        if (!this->refreshPreempted())
+            this->refreshPackages();
     });
     connect(pktr, &Transaction::errorCode, this,
-            [this](PackageKit::Transaction::Error /*error*/, const QString &details){
+            [this](PackageKit::Transaction::Error code, const QString &details){
+        if (code == PackageKit::Transaction::ErrorTransactionCancelled)
+            return; // preempted by a package operation
         qWarning() << "Failed to refresh Chum repository" << details;
         //% "Failed to refresh SailfishOS:Chum repository!"
         emit error(qtTrId("chum-refresh-repository-failed"));
@@ -336,14 +851,181 @@ void Chum::repositoriesListUpdated() {
                     qtTrId("chum-repo-management-disabled-txt").arg("for i in $(ssu lr | fgrep chum | cut -f 3 -d ' '); do ssu rr $i; done"));
         return;
     } else if (!m_ssu.repoAvailable()) {
+        if (m_repo_change_aborted) {
+            // the change was cancelled or failed, adding the repository
+            // again could fail the same way
+            m_repo_change_aborted = false;
+            if (m_repo_was_available)
+                //% "The previous SailfishOS:Chum repository could not be restored, it is not available now"
+                emit error(qtTrId("chum-repo-restore-failed"));
+            setStatus(QLatin1String(""));
+            m_busy = false;
+            emit busyChanged();
+            continueQueued();
+            return;
+        }
+        m_manualVersion_previous = m_manualVersion;
+        //% "Adding SailfishOS:Chum repository"
+        startRepoChange(qtTrId("chum-add-repo"), false);
+        return;
+    }
+    m_repo_change_aborted = false;
+    checkRepoFreshness();
+}
+
+/// Decides on startup whether the repository metadata has to be
+/// refreshed. The refresh is only forced if the repository changed,
+/// the last refresh is older than the configured TTL, or the remote
+/// revision of the metadata (repomd.xml ETag or modification time)
+/// differs from the one seen at the last refresh. Otherwise, packages
+/// are read from the local cache straight away.
+void Chum::checkRepoFreshness() {
+    QSettings settings;
+    const int ttl = settings.value(s_config_repo_ttl, s_repo_ttl_default).toInt();
+    const QDateTime last = settings.value(s_config_repo_refreshed).toDateTime();
+    const QString last_revision = settings.value(s_config_repo_revision).toString();
+    // the URL differs for another repository or Sailfish OS version
+    const QString url = m_ssu.repoUrl();
+    const bool expired = !last.isValid() || url.isEmpty() ||
+            settings.value(s_config_repo_url).toString() != url ||
+            last.secsTo(QDateTime::currentDateTimeUtc()) > ttl * 60;
+    m_repo_revision.clear();
+
+    if (url.isEmpty() || !nMng) {
+        refreshRepo(true);
+        return;
+    }
+
+    //% "Checking SailfishOS:Chum repository for changes"
+    setStatus(qtTrId("chum-check-repository"));
+
+    // Package operations requested during the check are started once it
+    // is done, in place of the refresh
+    if (!m_busy) {
         m_busy = true;
         emit busyChanged();
+    }
+    m_refreshing = true;
+
+    // The revision is fetched even if the metadata is expired, to be recorded after the refresh
+    const int serial = ++m_repo_revision_serial;
+    fetchRepoRevision([this, serial, expired, last_revision](const QString &revision) {
+        if (serial != m_repo_revision_serial) return;
+        m_repo_revision = revision;
+
+        m_refresh_repo = expired || (!revision.isEmpty() && revision != last_revision);
+        setStatus(QLatin1String(""));
+        if (this->refreshPreempted()) return;
+
+        if (m_refresh_repo) {
+            refreshRepo(true);
+            return;
+        }
+        qDebug() << "Chum repository metadata is up to date, skipping refresh";
+        refreshPackages();
+    });
+}
+
+// Revision of the repository metadata (repomd.xml ETag or modification
+// time), empty if it cannot be fetched
+void Chum::fetchRepoRevision(const std::function<void(const QString &revision)> &done) {
+    const QString url = m_ssu.repoUrl();
+    if (url.isEmpty() || !nMng) {
+        done(QString{});
+        return;
+    }
+
+    QNetworkRequest request(QUrl(url.endsWith('/') ? url : url + '/')
+                            .resolved(QUrl(QStringLiteral("repodata/repomd.xml"))));
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    QNetworkReply *reply = nMng->head(request);
+    connect(reply, &QNetworkReply::finished, this, [reply, done]() {
+        reply->deleteLater();
+        QString revision = QString::fromLatin1(reply->rawHeader("ETag"));
+        if (revision.isEmpty())
+            revision = QString::fromLatin1(reply->rawHeader("Last-Modified"));
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "Failed to check revision of Chum repository" << reply->errorString();
+            revision.clear();
+        }
+        done(revision);
+    });
+}
+
+// Record a successful refresh for the freshness check on the next start.
+// The revision is used only once, so that a later refresh does not
+// record a stale one.
+void Chum::setRepoRefreshed() {
+    QSettings settings;
+    settings.setValue(s_config_repo_url, m_ssu.repoUrl());
+    settings.setValue(s_config_repo_refreshed, QDateTime::currentDateTimeUtc());
+    if (!m_repo_revision.isEmpty())
+        settings.setValue(s_config_repo_revision, m_repo_revision);
+    else
+        settings.remove(s_config_repo_revision);
+    m_repo_revision.clear();
+    ++m_repo_revision_serial;
+}
+
+// Starts a change of the repository in SSU. If SSU does not accept
+// the change, the busy state is restored and false is returned.
+bool Chum::startRepoChange(const QString &status, bool testing) {
+    const bool was_busy = m_busy;
+    m_repo_was_available = m_ssu.repoAvailable();
+    m_busy = true;
+    emit busyChanged();
+    setStatus(status);
+    if (m_ssu.setRepo(m_manualVersion, testing))
+        return true;
+
+    //% "The SailfishOS:Chum repository cannot be changed now, please try again later"
+    emit error(qtTrId("chum-repo-change-rejected"));
+    setStatus(QLatin1String(""));
+    if (!was_busy) {
+        m_busy = false;
+        emit busyChanged();
+        continueQueued();
+    }
+    return false;
+}
+
+// The repository is restored by SSU, the settings follow it
+void Chum::repositoriesChangeAborted() {
+    m_repo_change_aborted = true;
+    if (m_manualVersion != m_manualVersion_previous) {
+        m_manualVersion = m_manualVersion_previous;
+        QSettings settings;
+        settings.setValue(s_config_manualversion, m_manualVersion);
+        emit manualVersionChanged();
+    }
+}
+
+void Chum::repositoriesStepChanged() {
+    emit repoChangingChanged();
+    switch (m_ssu.step()) {
+    case Ssu::StepRemoveRepo:
+        //% "Removing current SailfishOS:Chum repository"
+        setStatus(qtTrId("chum-repo-step-remove"));
+        break;
+    case Ssu::StepAddRepo:
         //% "Adding SailfishOS:Chum repository"
         setStatus(qtTrId("chum-add-repo"));
-        m_ssu.setRepo(m_manualVersion);
-        return;
+        break;
+    case Ssu::StepUpdateRepos:
+        //% "Updating repositories"
+        setStatus(qtTrId("chum-repo-step-update"));
+        break;
+    case Ssu::StepRestoreRepo:
+        //% "Restoring previous SailfishOS:Chum repository"
+        setStatus(qtTrId("chum-repo-step-restore"));
+        break;
+    default:
+        break;
     }
-    refreshRepo(true);
+}
+
+void Chum::cancelRepoChange() {
+    m_ssu.cancel();
 }
 
 void Chum::setRepoTesting(bool testing) {
@@ -353,93 +1035,182 @@ void Chum::setRepoTesting(bool testing) {
     }
 
     if (!m_ssu.repoAvailable() || m_ssu.repoTesting() != testing) {
-        m_busy = true;
-        emit busyChanged();
+        m_manualVersion_previous = m_manualVersion;
         //% "Adding SailfishOS:Chum:Testing repository"
-        setStatus(qtTrId("chum-add-testing-repo"));
-        m_ssu.setRepo(m_manualVersion, testing);
+        startRepoChange(qtTrId("chum-add-testing-repo"), testing);
     }
 }
 
 // Operations on packages: Install, remove and update
 void Chum::installPackage(const QString &id) {
-    if (m_busy) return;
+    if (m_busy) {
+        queueOperation([this, id]() { this->installPackage(id); });
+        return;
+    }
     ChumPackage *p = m_packages.value(id, nullptr);
     if (!p) return; // This package ID does not exist
     m_busy = true;
     emit busyChanged();
     //% "Installing package"
     setStatus(qtTrId("chum-install-package"));
-    QString pkid = p->pkidLatest();
-    startOperation(Daemon::installPackage(pkid), pkid);
+    const PackageId pkid = p->pkidLatest();
+    startOperation(Daemon::installPackage(pkid.toString()), pkid);
 }
 
 void Chum::uninstallPackage(const QString &id) {
-    if (m_busy) return;
+    if (m_busy) {
+        queueOperation([this, id]() { this->uninstallPackage(id); });
+        return;
+    }
     ChumPackage *p = m_packages.value(id, nullptr);
     if (!p) return; // This package ID does not exist
     m_busy = true;
     emit busyChanged();
     //% "Removing package"
     setStatus(qtTrId("chum-uninstall-package"));
-    QString pkid = p->pkidInstalled();
-    startOperation(Daemon::removePackage(pkid), pkid);
+    const PackageId pkid = p->pkidInstalled();
+    startOperation(Daemon::removePackage(pkid.toString()), pkid);
 }
 
 void Chum::updatePackage(const QString &id) {
-    if (m_busy) return;
+    if (m_busy) {
+        queueOperation([this, id]() { this->updatePackage(id); });
+        return;
+    }
     ChumPackage *p = m_packages.value(id, nullptr);
     if (!p) return; // This package ID does not exist
     m_busy = true;
     emit busyChanged();
     //% "Updating package"
     setStatus(qtTrId("chum-update-package"));
-    QString pkid = p->pkidLatest();
-    startOperation(Daemon::updatePackage(pkid), pkid);
+    const PackageId pkid = p->pkidLatest();
+    startOperation(Daemon::updatePackage(pkid.toString()), pkid);
 }
 
 void Chum::updateAllPackages() {
-    if (m_busy) return;
+    if (m_busy) {
+        queueOperation([this]() { this->updateAllPackages(); });
+        return;
+    }
     QStringList pkids;
     for (ChumPackage *p: m_packages)
         if (p->updateAvailable())
-            pkids.append(p->pkidLatest());
+            pkids.append(p->pkidLatest().toString());
     if (pkids.isEmpty()) return; // No package(s) to update
 
     m_busy = true;
     emit busyChanged();
     //% "Updating all packages"
     setStatus(qtTrId("chum-update-all-packages"));
-    startOperation(Daemon::updatePackages(pkids), QString{});
+    startOperation(Daemon::updatePackages(pkids), PackageId{});
+}
+
+// Queues a package operation requested while busy. A running refresh
+// sequence is preempted by it, otherwise it is started when the current
+// operation or package state update is done.
+void Chum::queueOperation(const std::function<void()> &operation) {
+    m_pending_operations.append(operation);
+    if (!m_refreshing) return;
+    if (m_refresh_transaction && m_refresh_transaction->allowCancel())
+        m_refresh_transaction->cancel();
+    //% "Stopping refresh for the requested operation"
+    setStatus(qtTrId("chum-refresh-preempted"));
+}
+
+// Called when busy state ended. Starts the next queued operation, skipping
+// those which do not start, e.g. as their package is gone, or restarts
+// the refresh postponed by the operations.
+void Chum::continueQueued() {
+    while (!m_busy && !m_pending_operations.isEmpty())
+        m_pending_operations.takeFirst()();
+    if (!m_busy && m_refresh_restart)
+        restartRefresh();
+}
+
+// Called at the boundaries of the refresh stages. If an operation is
+// pending, it is started instead of the next stage and true is returned.
+bool Chum::refreshPreempted() {
+    m_refresh_transaction.clear();
+    if (m_pending_operations.isEmpty()) return false;
+
+    m_refreshing = false;
+    m_refresh_restart = true;
+    m_trace_refresh_start = -1;
+    m_busy = false;
+    continueQueued();
+    if (!m_busy) emit busyChanged();
+    return true;
+}
+
+void Chum::restartRefresh() {
+    m_refresh_restart = false;
+    if (m_refresh_repo)
+        refreshRepo(true);
+    else
+        refreshPackages();
 }
 
-void Chum::startOperation(Transaction *pktr, const QString &pkg_id) {
+void Chum::startOperation(Transaction *pktr, const PackageId &pkg_id) {
+    m_progress->start(pktr);
+
+    // Collect names of all packages touched by the transaction, including
+    // dependencies, so that only those have to be refreshed afterwards
+    auto affected = QSharedPointer<QSet<QString>>::create();
+    if (!pkg_id.isEmpty())
+        affected->insert(packageId(pkg_id));
+    connect(pktr, &Transaction::package, this, [this, affected](
+            [[maybe_unused]] int info,
+            const QString &packageID,
+            [[maybe_unused]] const QString &summary
+            ) {
+        affected->insert(this->packageId(PackageId(packageID)));
+    });
+
     if (!pkg_id.isEmpty())
         connect(pktr, &Transaction::roleChanged, this, [this, pktr, pkg_id]() {
             emit this->packageOperationStarted(
                         role2operation(pktr->role()),
-                        Daemon::packageName(pkg_id)
+                        pkg_id.name()
                         );
         });
 
     connect(pktr, &Transaction::finished, this,
-            [this, pktr, pkg_id](PackageKit::Transaction::Exit status, uint /*runtime*/) {
+            [this, pktr, pkg_id, affected](PackageKit::Transaction::Exit status, uint /*runtime*/) {
         m_busy = false;
         emit busyChanged();
         setStatus(QLatin1String(""));
+        m_progress->finish(status == PackageKit::Transaction::ExitSuccess);
         if (status == PackageKit::Transaction::ExitSuccess)
             emit this->packageOperationFinished(
                     role2operation(pktr->role()),
-                    Daemon::packageName(pkg_id),
-                    Daemon::packageVersion(pkg_id)
+                    pkg_id.name(),
+                    pkg_id.version()
                     );
-        refreshPackages(); // Update details of all packages and their install-status
+
+        // A follow-up operation was started by a handler of the signal,
+        // the packages are refreshed after it
+        if (m_busy) {
+            if (affected->isEmpty())
+                m_refresh_restart = true;
+            m_state_refresh_pending.unite(*affected);
+            return;
+        }
+        affected->unite(m_state_refresh_pending);
+        m_state_refresh_pending.clear();
+
+        if (affected->isEmpty())
+            m_refresh_restart = true; // Nothing known about the changes, update all packages
+
+        if (affected->isEmpty() || (m_refresh_restart && m_pending_operations.isEmpty()))
+            continueQueued(); // Start queued operations or the refresh postponed by this operation
+        else
+            refreshPackagesState(*affected); // Update install-status of the affected packages only
     });
 
     connect(pktr, &Transaction::errorCode, this,
             [this, pktr, pkg_id](PackageKit::Transaction::Error /*error*/, const QString &details){
         qWarning() << "Failed" << role2operation(pktr->role())
-                   << pkg_id
+                   << pkg_id.toString()
                    << details;
         emit error(details);
     });
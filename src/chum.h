@@ -2,11 +2,16 @@
 
 #include <QHash>
 #include <QObject>
+#include <QPointer>
 #include <QSet>
 
 #include "chumpackage.h"
+#include "operationprogress.h"
+#include "packageid.h"
 #include "ssu.h"
 
+#include <functional>
+
 namespace PackageKit {
 class Transaction;
 }
@@ -15,7 +20,11 @@ class Chum : public QObject {
     Q_OBJECT
     Q_PROPERTY(bool    busy           READ busy NOTIFY busyChanged)
     Q_PROPERTY(quint32 installedCount READ installedCount NOTIFY installedCountChanged)
+    Q_PROPERTY(bool    lowEndProfile  READ lowEndProfile NOTIFY performanceProfileChanged)
+    Q_PROPERTY(int     performanceProfile READ performanceProfile WRITE setPerformanceProfile NOTIFY performanceProfileChanged)
+    Q_PROPERTY(OperationProgress* progress READ progress CONSTANT)
     Q_PROPERTY(bool    repoAvailable  READ repoAvailable NOTIFY repoUpdated)
+    Q_PROPERTY(bool    repoChanging   READ repoChanging NOTIFY repoChangingChanged)
     Q_PROPERTY(bool    repoManaged    READ repoManaged NOTIFY repoUpdated)
     Q_PROPERTY(bool    repoTesting    READ repoTesting WRITE setRepoTesting NOTIFY repoUpdated)
     Q_PROPERTY(bool    showAppsByDefault READ showAppsByDefault WRITE setShowAppsByDefault NOTIFY showAppsByDefaultChanged)
@@ -34,20 +43,33 @@ public:
 
     bool    busy() const { return m_busy; }
     quint32 installedCount() const { return m_installed_count; }
+    bool    lowEndProfile() const;
+    int     performanceProfile() const;
     bool    repoAvailable() const { return m_ssu.repoAvailable(); }
+    bool    repoChanging() const { return m_ssu.changing(); }
     bool    repoManaged() const { return m_ssu.manageRepo(); }
     bool    repoTesting() const { return m_ssu.repoTesting(); }
     bool    showAppsByDefault() const { return m_show_apps_by_default; };
     QString status() const { return m_status; }
+    OperationProgress* progress() const { return m_progress; }
     quint32 updatesCount() const { return m_updates_count; }
     QString manualVersion() const { return m_manualVersion; }
 
     void    setRepoTesting(bool testing);
+    void    setPerformanceProfile(int mode);
     void    setShowAppsByDefault(bool v);
     void    setManualVersion(const QString &v);
 
     const QList<ChumPackage*> packages() const { return m_packages.values(); }
     Q_INVOKABLE ChumPackage* package(const QString &id) const { return m_packages.value(id, nullptr); }
+    Q_INVOKABLE QVariantMap networkStatistics() const;
+    Q_INVOKABLE QVariantMap forgeStatistics() const;
+    Q_INVOKABLE QVariantMap detailsCacheStatistics() const;
+    Q_INVOKABLE QVariantMap memoryStatistics() const;
+    Q_INVOKABLE QVariantMap trimStatistics() const;
+    Q_INVOKABLE QVariantMap stallStatistics() const;
+    Q_INVOKABLE QVariantMap diagnostics() const;
+    Q_INVOKABLE bool saveDiagnostics(const QString &filename) const;
 
     // static public methods
     static Chum* instance();
@@ -59,6 +81,7 @@ public slots:
     void uninstallPackage(const QString &id);
     void updatePackage(const QString &id);
     void updateAllPackages();
+    void cancelRepoChange();
 
 signals:
     void busyChanged();
@@ -71,39 +94,91 @@ signals:
     void packageOperationStarted( Chum::PackageOperation operation, const QString &name);
     void packageOperationFinished(Chum::PackageOperation operation, const QString &name, const QString &version);
     void repoUpdated(); // signal ssu properties change
+    void repoChangingChanged();
     void repositoryRefreshed();
+    void performanceProfileChanged();
     void showAppsByDefaultChanged();
     void manualVersionChanged();
 
+private slots:
+    void memoryLevelChanged(const QString &level);
+
 private:
     explicit Chum(QObject *parent = nullptr);
 
-    QString packageId(const QString &pkg_id);
+    void applicationStateChanged(Qt::ApplicationState state);
+    void trimCaches(bool memory_pressure);
 
-    void repositoriesListUpdated();
+    QString packageId(const PackageId &pkid) const;
 
+    void repositoriesListUpdated();
+    void checkRepoFreshness();
+    void setRepoRefreshed();
+    void fetchRepoRevision(const std::function<void(const QString &revision)> &done);
+    void repositoriesStepChanged();
+    void repositoriesChangeAborted();
+    bool startRepoChange(const QString &status, bool testing);
+
+    void verifyUpdates();
     void getUpdatesFinished();
     void refreshPackages();
     void refreshPackagesInstalled();
     void refreshPackagesFinished();
     void refreshDetails();
     void refreshInstalledVersion();
-
-    void startOperation(PackageKit::Transaction *pktr, const QString &pkg_id);
+    void refreshPackagesState(const QSet<QString> &names);
+    void updateInstalledCount();
+    void updateUpdatesCount();
+    void saveUpdatesState();
+    void readCatalog(QSet<QString> &names, QSet<QString> &others) const;
+    void saveCatalog() const;
+
+    void queueOperation(const std::function<void()> &operation);
+    void continueQueued();
+    bool refreshPreempted();
+    void restartRefresh();
+    void startOperation(PackageKit::Transaction *pktr, const PackageId &pkg_id);
+    void traceStage(PackageKit::Transaction *pktr, const QString &stage, int items);
     void setStatus(QString status);
 
 private:
     Ssu           m_ssu;
     bool          m_busy{false};
     QString       m_status;
+    OperationProgress *m_progress{nullptr};
     quint32       m_installed_count{0};
     quint32       m_updates_count{0};
     bool          m_show_apps_by_default{false};
     QString       m_manualVersion;
+    QString       m_manualVersion_previous; // restored if the repository change is cancelled or fails
+    bool          m_repo_change_aborted{false};
+    bool          m_repo_was_available{false}; // before the running repository change
+    QString       m_repo_revision;
+    int           m_repo_revision_serial{0}; // ignores revisions fetched for an earlier refresh
+
+    bool          m_verify_updates{false};
+    qint64        m_trace_refresh_start{-1};
+
+    // trimming of caches in background and on memory pressure
+    bool          m_background{false};
+    qint64        m_trim_count{0};
+    qint64        m_trimmed_bytes{0};
+    qint64        m_last_trimmed_bytes{0};
+
+    // refresh sequence and the user operation preempting it
+    bool          m_refreshing{false};
+    bool          m_refresh_repo{false};
+    bool          m_refresh_restart{false};
+    QPointer<PackageKit::Transaction> m_refresh_transaction;
+    QList<std::function<void()>>      m_pending_operations;
+
+    // packages changed by an operation, refreshed after a follow-up operation
+    QSet<QString> m_state_refresh_pending;
 
     QHash<QString, ChumPackage*> m_packages;
-    QSet<QString>                m_packages_last_refresh;
-    QSet<QString>                m_packages_last_refresh_installed;
+    QSet<QString>                m_catalog_others; // installed packages not provided by Chum
+    QSet<PackageId>              m_packages_last_refresh;
+    QSet<PackageId>              m_packages_last_refresh_installed;
 
     // static
     static Chum*         s_instance;
@@ -1,4 +1,7 @@
 #include "chumpackage.h"
+#include "detailscache.h"
+#include "rpmversion.h"
+#include "stallwatchdog.h"
 
 #include "projectgithub.h"
 #include "projectgitlab.h"
@@ -7,12 +10,21 @@
 #include <PackageKit/Daemon>
 #include <PackageKit/Details>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QPointer>
 #include <QRegularExpression>
 #include <yaml-cpp/yaml.h>
 
+// descriptions shorter than this are not compressed when trimming
+static const int s_pack_min_chars{512};
+
+bool ChumPackage::s_hydration_paused{false};
+QList<QPointer<ChumPackage>> ChumPackage::s_hydration_pending;
+ChumPackage::TrimStatistics ChumPackage::s_trim_stats;
+
 using namespace PackageKit;
 
 #define SET_IF_EMPTY(var, role, value) { \
@@ -24,10 +36,8 @@ using namespace PackageKit;
 ChumPackage::ChumPackage(QObject *parent)
     : QObject{parent}
 {
-    m_issue_info = new LoadableObject(this);
-    m_issues = new LoadableObject(this);
-    m_release_info = new LoadableObject(this);
-    m_releases = new LoadableObject(this);
+    // project and objects used by issues and releases views are
+    // allocated on the first use
 }
 
 
@@ -57,41 +67,167 @@ bool ChumPackage::installed() const {
     return !m_installed_version.isEmpty();
 }
 
+QString ChumPackage::description() const {
+    // restore description compressed by trim when it is read
+    if (!m_description_packed.isEmpty()) {
+        QElapsedTimer timer;
+        timer.start();
+        m_description = peekDescription();
+        m_description_packed.clear();
+        ++s_trim_stats.descriptions_restored;
+        s_trim_stats.restore_usecs += timer.nsecsElapsed() / 1000;
+    }
+    return m_description;
+}
+
+QString ChumPackage::peekDescription() const {
+    if (m_description_packed.isEmpty()) return m_description;
+    return QString::fromUtf8(qUncompress(m_description_packed));
+}
+
+// true if the latest available version is newer than the installed one
+bool ChumPackage::newerVersionAvailable() const {
+    if (!installed() || m_pkid_latest.isEmpty()) return false;
+    return RpmVersion::compareEvr(m_pkid_latest.version(), m_pkid_installed.version()) > 0;
+}
+
+ProjectAbstract* ChumPackage::project() {
+    if (m_project || m_project_url.isEmpty()) return m_project;
+    if (ProjectGitHub::isProject(m_project_url))
+        m_project = new ProjectGitHub(m_project_url, this);
+    else if (ProjectGitLab::isProject(m_project_url))
+        m_project = new ProjectGitLab(m_project_url, this);
+    else if (ProjectForgejo::isProject(m_project_url))
+        m_project = new ProjectForgejo(m_project_url, this);
+    return m_project;
+}
+
+void ChumPackage::loadProject() {
+    project();
+}
+
+void ChumPackage::requestProject() {
+    if (m_project || m_project_url.isEmpty()) return;
+    if (s_hydration_paused) {
+        if (!m_hydration_pending) {
+            m_hydration_pending = true;
+            s_hydration_pending.append(this);
+            ++s_trim_stats.hydrations_deferred;
+        }
+        return;
+    }
+    QMetaObject::invokeMethod(this, "loadProject", Qt::QueuedConnection);
+}
+
+void ChumPackage::viewOpened() {
+    ++m_views;
+}
+
+void ChumPackage::viewClosed() {
+    if (m_views > 0) --m_views;
+}
+
+// static
+void ChumPackage::setHydrationPaused(bool paused) {
+    s_hydration_paused = paused;
+    if (paused) return;
+
+    const QList<QPointer<ChumPackage>> pending = s_hydration_pending;
+    s_hydration_pending.clear();
+    for (const QPointer<ChumPackage> &p: pending)
+        if (p) {
+            p->m_hydration_pending = false;
+            p->requestProject();
+            ++s_trim_stats.hydrations_resumed;
+        }
+}
+
 LoadableObject* ChumPackage::issue(const QString &id) {
-    if (m_project != nullptr)
-        m_project->issue(id, m_issue_info);
+    if (!m_issue_info) m_issue_info = new LoadableObject(this);
+    if (project() != nullptr)
+        loadDetails(QStringLiteral("issue"), id, m_issue_info);
     else
         m_issue_info->setEmpty();
     return m_issue_info;
 }
 
-LoadableObject* ChumPackage::issues() {
-    if (m_issues->ready()) return m_issues;
-    if (m_project != nullptr)
-        m_project->issues(m_issues);
+PagedModel* ChumPackage::issues() {
+    if (!m_issues) m_issues = new IssuesModel(this);
+    if (m_issues->ready() || m_issues->started()) return m_issues;
+    if (project() != nullptr) {
+        ProjectAbstract *project = m_project;
+        IssuesModel *model = m_issues;
+        m_issues->setFetcher([project, model](){ project->issues(model); });
+        m_issues->loadMore();
+    }
     else
         m_issues->setEmpty();
     return m_issues;
 }
 
 LoadableObject* ChumPackage::release(const QString &id) {
-    if (m_project != nullptr)
-        m_project->release(id, m_release_info);
+    if (!m_release_info) m_release_info = new LoadableObject(this);
+    if (project() != nullptr)
+        loadDetails(QStringLiteral("release"), id, m_release_info);
     else
         m_release_info->setEmpty();
     return m_release_info;
 }
 
-LoadableObject* ChumPackage::releases() {
-    if (m_releases->ready()) return m_releases;
-    if (m_project != nullptr)
-        m_project->releases(m_releases);
+PagedModel* ChumPackage::releases() {
+    if (!m_releases) m_releases = new ReleasesModel(this);
+    if (m_releases->ready() || m_releases->started()) return m_releases;
+    if (project() != nullptr) {
+        ProjectAbstract *project = m_project;
+        ReleasesModel *model = m_releases;
+        m_releases->setFetcher([project, model](){ project->releases(model); });
+        m_releases->loadMore();
+    }
     else
         m_releases->setEmpty();
     return m_releases;
 }
 
-void ChumPackage::setPkidLatest(const QString &pkid) {
+void ChumPackage::loadDetails(const QString &kind, const QString &id, LoadableObject *target) {
+    // Cached details are shown immediately and revalidated in the
+    // background unless they were loaded very recently. Fetching is done
+    // into a separate object to keep the shown value until the new one
+    // arrives.
+    const QString key = DetailsCache::key(m_project_url, kind, id);
+    QVariantMap cached;
+    bool fresh = false;
+    if (DetailsCache::instance()->find(key, cached, &fresh)) {
+        if (target->valueId() != id || !target->ready()) {
+            target->reset(id);
+            target->setValue(id, cached);
+        }
+        if (fresh) return;
+    } else {
+        if (target->ready() && target->valueId() == id) return;
+        target->reset(id);
+    }
+
+    // target may be dropped by trim while fetching
+    QPointer<LoadableObject> shown(target);
+    LoadableObject *fetched = new LoadableObject(this);
+    connect(fetched, &LoadableObject::readyChanged, this, [key, id, shown, fetched](){
+        if (!fetched->ready()) return;
+        const QVariantMap v = fetched->value();
+        // empty value signals failure, cached value is kept then
+        if (!v.isEmpty())
+            DetailsCache::instance()->insert(key, v);
+        if (shown && shown->valueId() == id && (!v.isEmpty() || !shown->ready()))
+            shown->setValue(id, v);
+        fetched->deleteLater();
+    });
+
+    if (kind == QLatin1String("issue"))
+        m_project->issue(id, fetched);
+    else
+        m_project->release(id, fetched);
+}
+
+void ChumPackage::setPkidLatest(const PackageId &pkid) {
     if (m_pkid_latest == pkid) return;
 
     m_pkid_latest = pkid;
@@ -111,17 +247,21 @@ void ChumPackage::setUpdateAvailable(bool up) {
 }
 
 void ChumPackage::setDetails(const PackageKit::Details &v) {
+    StallWatchdog::Section section("package details");
     m_details_update = false;
 
-    m_available_version = Daemon::packageVersion(v.packageId());
+    const QString details_pkid = v.packageId();
+    m_available_version = details_pkid == m_pkid_latest.toString() ?
+                m_pkid_latest.version() : PackageId(details_pkid).version();
     m_description = v.description();
+    m_description_packed.clear();
     m_summary     = v.summary();
     m_url         = v.url();
     m_license     = v.license();
     m_size        = v.size();
 
     // derive name
-    QString pname = Daemon::packageName(m_pkid_latest);
+    QString pname = m_pkid_latest.name();
     m_package_name = pname;
     m_name = QString{};
     QStringList nparts = pname.split('-');
@@ -232,27 +372,113 @@ void ChumPackage::setDetails(const PackageKit::Details &v) {
         m_donation = json.value("Url").toObject().value("Donation").toString();
     }
 
-    for (const QString &u: {m_packaging_repo_url, m_repo_url, m_url}) {
-        if (ProjectGitHub::isProject(u))
-            m_project = new ProjectGitHub(u, this);
-        else if (ProjectGitLab::isProject(u))
-            m_project = new ProjectGitLab(u, this);
-        else if (ProjectForgejo::isProject(u))
-            m_project = new ProjectForgejo(u, this);
-        if (m_project) break;
+    // project is created when it is used for the first time
+    if (!m_project) {
+        m_project_url.clear();
+        for (const QString &u: {m_packaging_repo_url, m_repo_url, m_url}) {
+            if (ProjectGitHub::isProject(u) || ProjectGitLab::isProject(u) ||
+                    ProjectForgejo::isProject(u)) {
+                m_project_url = u;
+                break;
+            }
+        }
     }
 
     emit updated(m_id, PackageRefreshRole);
 }
 
+static qint64 stringBytes(const QString &s) {
+    return s.capacity()*2;
+}
+
+static qint64 stringBytes(const QStringList &l) {
+    qint64 b = l.size()*sizeof(QString);
+    for (const QString &s: l) b += stringBytes(s);
+    return b;
+}
+
+void ChumPackage::addMemoryUsage(MemoryUsage &usage) const {
+    usage.metadata += sizeof(ChumPackage);
+    usage.metadata += m_pkid_latest.bytes() + m_pkid_installed.bytes();
+    for (const QString *s: {&m_id, &m_installed_version,
+         &m_available_version, &m_description_md_url, &m_developer_login, &m_developer_name,
+         &m_donation, &m_icon, &m_license, &m_name, &m_package_name, &m_packager_login,
+         &m_packager_name, &m_packaging_repo_url, &m_repo_url, &m_summary, &m_url,
+         &m_url_forum, &m_url_issues, &m_desktopFile, &m_project_url})
+        usage.metadata += stringBytes(*s);
+    usage.metadata += stringBytes(m_categories) + stringBytes(m_screenshots);
+
+    usage.descriptions += stringBytes(m_description) + m_description_packed.size();
+
+    for (const LoadableObject *o: {m_issue_info, m_release_info})
+        if (o) {
+            usage.objects += sizeof(LoadableObject) + DetailsCache::estimateSize(o->value());
+            usage.objects_count++;
+        }
+    if (m_issues) {
+        usage.objects += sizeof(IssuesModel) + m_issues->rowCount()*sizeof(IssueItem);
+        usage.objects_count++;
+    }
+    if (m_releases) {
+        usage.objects += sizeof(ReleasesModel) + m_releases->rowCount()*sizeof(ReleaseItem);
+        usage.objects_count++;
+    }
+    if (m_project) usage.projects_count++;
+}
+
+qint64 ChumPackage::trim() {
+    if (m_views > 0) return 0;
+
+    qint64 bytes = 0;
+    for (LoadableObject **o: {&m_issue_info, &m_release_info})
+        if (*o) {
+            bytes += sizeof(LoadableObject) + DetailsCache::estimateSize((*o)->value());
+            (*o)->deleteLater();
+            *o = nullptr;
+            ++s_trim_stats.objects;
+        }
+    if (m_issues) {
+        bytes += sizeof(IssuesModel) + m_issues->rowCount()*sizeof(IssueItem);
+        m_issues->deleteLater();
+        m_issues = nullptr;
+        ++s_trim_stats.objects;
+    }
+    if (m_releases) {
+        bytes += sizeof(ReleasesModel) + m_releases->rowCount()*sizeof(ReleaseItem);
+        m_releases->deleteLater();
+        m_releases = nullptr;
+        ++s_trim_stats.objects;
+    }
+
+    if (m_description.size() >= s_pack_min_chars) {
+        m_description_packed = qCompress(m_description.toUtf8());
+        bytes += stringBytes(m_description) - m_description_packed.size();
+        m_description = QString{};
+        ++s_trim_stats.descriptions_packed;
+    }
+    return bytes;
+}
+
+// static
+QVariantMap ChumPackage::trimStatistics() {
+    return QVariantMap{
+        {QStringLiteral("objectsDropped"), s_trim_stats.objects},
+        {QStringLiteral("descriptionsPacked"), s_trim_stats.descriptions_packed},
+        {QStringLiteral("descriptionsRestored"), s_trim_stats.descriptions_restored},
+        {QStringLiteral("descriptionsRestoreUs"), s_trim_stats.restore_usecs},
+        {QStringLiteral("hydrationsDeferred"), s_trim_stats.hydrations_deferred},
+        {QStringLiteral("hydrationsResumed"), s_trim_stats.hydrations_resumed}
+    };
+}
+
 void ChumPackage::clearInstalled() {
-    setPkidInstalled(QString{});
+    setPkidInstalled(PackageId{});
 }
 
-void ChumPackage::setPkidInstalled(const QString &pkid) {
+void ChumPackage::setPkidInstalled(const PackageId &pkid) {
     if (m_pkid_installed == pkid) return;
     m_pkid_installed = pkid;
-    setInstalledVersion(Daemon::packageVersion(pkid));
+    setInstalledVersion(pkid.version());
 }
 
 void ChumPackage::setInstalledVersion(const QString &v)
@@ -262,7 +488,7 @@ void ChumPackage::setInstalledVersion(const QString &v)
     emit updated(m_id, PackageInstalledVersionRole);
     emit updated(m_id, PackageInstalledRole);
     if (type() == PackageApplicationDesktop && installed()) {
-        auto trfl = Daemon::getFiles(m_pkid_installed);
+        auto trfl = Daemon::getFiles(m_pkid_installed.toString());
         connect(trfl, &Transaction::files, this, [this](
                 const QString &packageID, const QStringList &filenames)
         {
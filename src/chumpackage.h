@@ -1,9 +1,13 @@
 #pragma once
 
+#include <QList>
 #include <QObject>
+#include <QPointer>
 #include <PackageKit/Details>
 
 #include "loadableobject.h"
+#include "packageid.h"
+#include "forgemodels.h"
 #include "projectabstract.h"
 
 class ChumPackage : public QObject {
@@ -69,28 +73,50 @@ public:
     };
     Q_ENUM(PackageType)
 
+    // approximate memory used by packages, in bytes
+    struct MemoryUsage {
+        qint64 metadata{0};
+        qint64 descriptions{0};
+        qint64 objects{0};
+        int    objects_count{0};
+        int    projects_count{0};
+    };
+
     ChumPackage(QObject *parent = nullptr);
     ChumPackage(const QString &id, QObject *parent = nullptr);
 
     Q_INVOKABLE LoadableObject* issue(const QString &id);
-    Q_INVOKABLE LoadableObject* issues();
+    Q_INVOKABLE PagedModel* issues();
     Q_INVOKABLE LoadableObject* release(const QString &id);
-    Q_INVOKABLE LoadableObject* releases();
+    Q_INVOKABLE PagedModel* releases();
+
+    // creates project on the first call and fetches its information
+    Q_INVOKABLE void loadProject();
+    // same as loadProject, but delayed to the next event loop iteration
+    void requestProject();
+
+    // pages showing the package, objects of shown packages are not trimmed
+    Q_INVOKABLE void viewOpened();
+    Q_INVOKABLE void viewClosed();
 
     QString id() const { return m_id; }
-    QString pkidLatest() const { return m_pkid_latest; }
-    QString pkidInstalled() const { return m_pkid_installed; }
+    PackageId pkidLatest() const { return m_pkid_latest; }
+    PackageId pkidInstalled() const { return m_pkid_installed; }
     bool detailsNeedsUpdate() const { return m_details_update; }
 
     QString availableVersion() const { return m_available_version; }
     QStringList categories() const { return m_categories; }
-    QString description() const { return m_description; }
+    QString description() const;
+    // description without keeping it expanded if it was compressed by
+    // trim, for reads over the whole catalog such as search
+    QString peekDescription() const;
     QString descriptionMDUrl() const { return m_description_md_url; }
     QString developer() const;
     QString donation() const { return m_donation; }
     int     forksCount() const { return m_forks_count; }
     QString icon() const { return m_icon; }
     bool    installed() const;
+    bool    newerVersionAvailable() const;
     QString installedVersion() const { return m_installed_version; }
     int     issuesCount() const { return m_issues_count; }
     QString license() const { return m_license; }
@@ -111,11 +137,21 @@ public:
     QString urlIssues() const { return m_url_issues; }
     QString desktopFile() const { return m_desktopFile; }
 
-    void setPkidLatest(const QString &pkid);
-    void setPkidInstalled(const QString &pkid);
+    void setPkidLatest(const PackageId &pkid);
+    void setPkidInstalled(const PackageId &pkid);
     void setUpdateAvailable(bool up);
     void setDetails(const PackageKit::Details &v);
     void clearInstalled();
+    void addMemoryUsage(MemoryUsage &usage) const;
+
+    // drops loaded issues and releases and compresses the description,
+    // returns estimate of the released memory
+    qint64 trim();
+
+    // project creation is deferred while paused
+    static void setHydrationPaused(bool paused);
+    // numbers of trimmed objects and the cost of restoring them
+    static QVariantMap trimStatistics();
 
     void setDeveloperLogin(const QString &login);
     void setDeveloperName(const QString &name);
@@ -135,25 +171,40 @@ signals:
     void updateAvailableChanged();
 
 private:
+    struct TrimStatistics {
+        qint64 objects{0};
+        qint64 descriptions_packed{0};
+        qint64 descriptions_restored{0};
+        qint64 restore_usecs{0};
+        qint64 hydrations_deferred{0};
+        qint64 hydrations_resumed{0};
+    };
+
+    ProjectAbstract* project();
+    void loadDetails(const QString &kind, const QString &id, LoadableObject *target);
     void setInstalledVersion(const QString &v);
 
 private:
     ProjectAbstract *m_project{nullptr};
+    QString          m_project_url;
+    int              m_views{0};
+    bool             m_hydration_pending{false};
     LoadableObject  *m_issue_info{nullptr};
-    LoadableObject  *m_issues{nullptr};
+    IssuesModel     *m_issues{nullptr};
     LoadableObject  *m_release_info{nullptr};
-    LoadableObject  *m_releases{nullptr};
+    ReleasesModel   *m_releases{nullptr};
 
     QString     m_id; // ID of the package as used in Chum
-    QString     m_pkid_latest; // Package ID as set by PackageKit
-    QString     m_pkid_installed; // Package ID as set by PackageKit
+    PackageId   m_pkid_latest; // Package ID as set by PackageKit
+    PackageId   m_pkid_installed; // Package ID as set by PackageKit
     QString     m_installed_version;
     bool        m_update_available{false};
     bool        m_details_update{false};
 
     QString     m_available_version;
     QStringList m_categories;
-    QString     m_description;
+    mutable QString    m_description;
+    mutable QByteArray m_description_packed; // compressed UTF-8 of trimmed description
     QString     m_description_md_url;
     QString     m_developer_login;
     QString     m_developer_name;
@@ -180,4 +231,9 @@ private:
     QString     m_url_forum;
     QString     m_url_issues;
     QString     m_desktopFile;
+
+    // static
+    static bool                         s_hydration_paused;
+    static QList<QPointer<ChumPackage>> s_hydration_pending;
+    static TrimStatistics               s_trim_stats;
 };
@@ -1,5 +1,8 @@
 #include "chumpackagesmodel.h"
 #include "chum.h"
+#include "performanceprofile.h"
+#include "stallwatchdog.h"
+#include "tracer.h"
 
 #include <QDebug>
 
@@ -9,6 +12,9 @@ ChumPackagesModel::ChumPackagesModel(QObject *parent)
     : QAbstractListModel{parent}
 {
     connect(Chum::instance(), &Chum::packagesChanged, this, &ChumPackagesModel::reset);
+
+    m_search_timer.setSingleShot(true);
+    connect(&m_search_timer, &QTimer::timeout, this, &ChumPackagesModel::reset);
 }
 
 int ChumPackagesModel::rowCount(const QModelIndex &parent) const {
@@ -20,7 +26,7 @@ QVariant ChumPackagesModel::data(const QModelIndex &index, int role) const {
         return QVariant{};
     }
 
-    const ChumPackage *p = Chum::instance()->package(m_packages[index.row()]);
+    ChumPackage *p = Chum::instance()->package(m_packages[index.row()]);
     switch (role) {
     case ChumPackage::PackageIdRole:
         return p->id();
@@ -51,6 +57,14 @@ QVariant ChumPackagesModel::data(const QModelIndex &index, int role) const {
     }
 }
 
+// Projects are created only for packages that are shown, requested by
+// the delegate of the row when it is created
+void ChumPackagesModel::fetch(int row) {
+    if (row < 0 || row >= m_packages.size()) return;
+    ChumPackage *p = Chum::instance()->package(m_packages[row]);
+    if (p) p->requestProject();
+}
+
 QHash<int, QByteArray> ChumPackagesModel::roleNames() const {
     return {
         {ChumPackage::PackageIdRole,       QByteArrayLiteral("packageId")},
@@ -70,6 +84,9 @@ QHash<int, QByteArray> ChumPackagesModel::roleNames() const {
 
 void ChumPackagesModel::reset() {
     if (m_postpone_loading) return;
+    m_search_timer.stop();
+    StallWatchdog::Section section("model reset");
+    const qint64 trace_start = Tracer::instance()->now();
     beginResetModel();
 
     m_packages.clear();
@@ -96,7 +113,7 @@ void ChumPackagesModel::reset() {
                         p->summary(),
                         p->categories().join(' '),
                         p->developer(),
-                        p->description() };
+                        p->peekDescription() };
             QString txt = lines.join('\n').normalized(QString::NormalizationForm_KC).toLower();
             for (QString query: m_search.split(' ', QString::SkipEmptyParts)) {
                 query = query.normalized(QString::NormalizationForm_KC).toLower();
@@ -120,6 +137,11 @@ void ChumPackagesModel::reset() {
         m_packages.push_back(p->id());
 
     endResetModel();
+
+    Tracer::instance()->complete(QStringLiteral("modelReset"), QStringLiteral("model"), trace_start, {
+                                     {QStringLiteral("catalog"), Chum::instance()->packages().size()},
+                                     {QStringLiteral("rows"), m_packages.size()}
+                                 });
 }
 
 void ChumPackagesModel::updatePackage(QString packageId, ChumPackage::Role role) {
@@ -211,6 +233,13 @@ void ChumPackagesModel::setSearch(QString search) {
     if (search == m_search) return;
     m_search = search;
     emit searchChanged();
+
+    const int delay = PerformanceProfile::instance()->searchDebounceMs();
+    if (delay > 0 && !m_search.isEmpty()) {
+        m_search_timer.start(delay);
+        return;
+    }
+    m_search_timer.stop();
     reset();
 }
 
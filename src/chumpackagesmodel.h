@@ -3,6 +3,7 @@
 #include <QAbstractListModel>
 #include <QQmlParserStatus>
 #include <QSet>
+#include <QTimer>
 
 #include "chumpackage.h"
 
@@ -35,6 +36,8 @@ public:
     void setShowCategory(QString category);
 
     Q_INVOKABLE void reset();
+    // loads project information, such as stars, of the package in the row
+    Q_INVOKABLE void fetch(int row);
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
@@ -61,5 +64,6 @@ private:
     bool m_filter_installed_only{false};
     bool m_filter_updates_only{false};
     QString m_search;
+    QTimer  m_search_timer; // delays filtering while typing on low-end devices
     QSet<QString> m_show_category;
 };
@@ -0,0 +1,94 @@
+#include "detailscache.h"
+#include "forgemodels.h"
+#include "performanceprofile.h"
+
+#include <QDateTime>
+#include <QVariantList>
+
+// cached values younger than this are not revalidated
+static const qint64 s_fresh_msecs{60*1000};
+
+DetailsCache *DetailsCache::s_instance{nullptr};
+
+DetailsCache::DetailsCache()
+{
+    m_cache.setMaxCost(PerformanceProfile::instance()->detailsCacheBytes());
+}
+
+DetailsCache* DetailsCache::instance() {
+    if (!s_instance) s_instance = new DetailsCache();
+    return s_instance;
+}
+
+QString DetailsCache::key(const QString &project, const QString &kind, const QString &id) {
+    return project + QLatin1Char('#') + kind + QLatin1Char('/') + id;
+}
+
+bool DetailsCache::find(const QString &key, QVariantMap &value, bool *fresh) {
+    Entry *e = m_cache.object(key);
+    if (!e) {
+        ++m_misses;
+        return false;
+    }
+    ++m_hits;
+    value = e->value;
+    if (fresh)
+        *fresh = QDateTime::currentMSecsSinceEpoch() - e->loaded < s_fresh_msecs;
+    return true;
+}
+
+void DetailsCache::insert(const QString &key, const QVariantMap &value) {
+    const qint64 size = estimateSize(value) + key.size()*2;
+    m_cache.insert(key, new Entry{value, QDateTime::currentMSecsSinceEpoch()},
+                   int(qMin<qint64>(size, m_cache.maxCost() + 1)));
+}
+
+void DetailsCache::setMaxBytes(int bytes) {
+    m_cache.setMaxCost(bytes);
+}
+
+void DetailsCache::clear() {
+    m_cache.clear();
+}
+
+QVariantMap DetailsCache::statistics() const {
+    const qint64 lookups = m_hits + m_misses;
+    return QVariantMap{
+        {QStringLiteral("entries"), m_cache.count()},
+        {QStringLiteral("bytes"), m_cache.totalCost()},
+        {QStringLiteral("maxBytes"), m_cache.maxCost()},
+        {QStringLiteral("hits"), m_hits},
+        {QStringLiteral("misses"), m_misses},
+        {QStringLiteral("hitRate"), lookups > 0 ? double(m_hits) / lookups : 0.0}
+    };
+}
+
+qint64 DetailsCache::estimateSize(const QVariant &v) {
+    // rough estimate: UTF-16 payload of strings and a fixed overhead per node
+    static const qint64 node{32};
+    switch (v.type()) {
+    case QVariant::String:
+        return node + v.toString().size()*2;
+    case QVariant::Map: {
+        qint64 s = node;
+        const QVariantMap m = v.toMap();
+        for (auto i = m.cbegin(); i != m.cend(); ++i)
+            s += node + i.key().size()*2 + estimateSize(i.value());
+        return s;
+    }
+    case QVariant::List: {
+        qint64 s = node;
+        for (const QVariant &e: v.toList())
+            s += estimateSize(e);
+        return s;
+    }
+    default:
+        if (v.userType() == qMetaTypeId<Discussion>()) {
+            qint64 s = node;
+            for (const CommentItem &c: v.value<Discussion>())
+                s += node + (c.author.size() + c.body.size())*2 + 2*sizeof(qint64);
+            return s;
+        }
+        return node;
+    }
+}
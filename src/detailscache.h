@@ -0,0 +1,47 @@
+#ifndef DETAILSCACHE_H
+#define DETAILSCACHE_H
+
+#include <QCache>
+#include <QString>
+#include <QVariantMap>
+
+/// Memory-bounded LRU cache of loaded issue and release details, shared
+/// by all packages. Entries are keyed by project, kind and ID, and their
+/// cost is an estimate of the memory used by the value. Used from the
+/// main thread only.
+class DetailsCache
+{
+public:
+    static DetailsCache* instance();
+
+    static QString key(const QString &project, const QString &kind, const QString &id);
+
+    // returns true if found, fresh is set if the value does not need revalidation
+    bool find(const QString &key, QVariantMap &value, bool *fresh = nullptr);
+    void insert(const QString &key, const QVariantMap &value);
+    void clear();
+    void setMaxBytes(int bytes);
+
+    QVariantMap statistics() const;
+    qint64 bytes() const { return m_cache.totalCost(); }
+
+    // rough estimate of memory used by the value
+    static qint64 estimateSize(const QVariant &v);
+
+private:
+    DetailsCache();
+
+private:
+    struct Entry {
+        QVariantMap value;
+        qint64      loaded;
+    };
+
+    QCache<QString, Entry> m_cache; // cost in bytes
+    qint64 m_hits{0};
+    qint64 m_misses{0};
+
+    static DetailsCache *s_instance;
+};
+
+#endif // DETAILSCACHE_H
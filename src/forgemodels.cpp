@@ -0,0 +1,135 @@
+#include "forgemodels.h"
+
+#include <QDateTime>
+#include <QLocale>
+
+//////////////////////////////////////////////////////
+/// DateFormatter
+
+qint64 DateFormatter::parse(const QString &txt) {
+    const QDateTime dt = QDateTime::fromString(txt, Qt::ISODate);
+    return dt.isValid() ? dt.toMSecsSinceEpoch() : 0;
+}
+
+QString DateFormatter::format(qint64 msecs, bool short_format) {
+    if (msecs == 0) return QString{};
+    // system locale lookup is not cheap, keep it for all calls
+    static const QLocale locale = QLocale::system();
+    return locale.toString(QDateTime::fromMSecsSinceEpoch(msecs).toLocalTime().date(),
+                           short_format ? QLocale::ShortFormat : QLocale::LongFormat);
+}
+
+//////////////////////////////////////////////////////
+/// IssuesModel
+
+IssuesModel::IssuesModel(QObject *parent)
+    : PagedListModel<IssueItem>{parent}
+{
+}
+
+QVariant IssuesModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_items.size()) return QVariant{};
+    const IssueItem &item = m_items.at(index.row());
+    switch (role) {
+    case IdRole:
+    case NumberRole:
+        return item.number;
+    case AuthorRole:
+        return item.author;
+    case CommentsCountRole:
+        return item.comments_count;
+    case TitleRole:
+        return item.title;
+    case CreatedRole:
+        return DateFormatter::format(item.created, true);
+    case UpdatedRole:
+        return DateFormatter::format(item.updated, true);
+    }
+    return QVariant{};
+}
+
+QHash<int, QByteArray> IssuesModel::roleNames() const {
+    return {
+        {IdRole, "id"},
+        {AuthorRole, "author"},
+        {CommentsCountRole, "commentsCount"},
+        {NumberRole, "number"},
+        {TitleRole, "title"},
+        {CreatedRole, "created"},
+        {UpdatedRole, "updated"}
+    };
+}
+
+//////////////////////////////////////////////////////
+/// ReleasesModel
+
+ReleasesModel::ReleasesModel(QObject *parent)
+    : PagedListModel<ReleaseItem>{parent}
+{
+}
+
+QVariant ReleasesModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_items.size()) return QVariant{};
+    const ReleaseItem &item = m_items.at(index.row());
+    switch (role) {
+    case IdRole:
+        return item.id;
+    case NameRole:
+        return item.name;
+    case DatetimeRole:
+        return DateFormatter::format(item.datetime, false);
+    }
+    return QVariant{};
+}
+
+QHash<int, QByteArray> ReleasesModel::roleNames() const {
+    return {
+        {IdRole, "id"},
+        {NameRole, "name"},
+        {DatetimeRole, "datetime"}
+    };
+}
+
+//////////////////////////////////////////////////////
+/// CommentsModel
+
+CommentsModel::CommentsModel(QObject *parent)
+    : QAbstractListModel{parent}
+{
+}
+
+void CommentsModel::setDiscussion(const QVariant &discussion) {
+    beginResetModel();
+    m_items = discussion.value<Discussion>();
+    endResetModel();
+    emit discussionChanged();
+}
+
+int CommentsModel::rowCount(const QModelIndex &parent) const {
+    return !parent.isValid() ? m_items.size() : 0;
+}
+
+QVariant CommentsModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_items.size()) return QVariant{};
+    const CommentItem &item = m_items.at(index.row());
+    switch (role) {
+    case AuthorRole:
+        return item.author;
+    case BodyRole:
+        return item.body;
+    case CreatedRole:
+        return DateFormatter::format(item.created, true);
+    case UpdatedRole:
+        return DateFormatter::format(item.updated, true);
+    }
+    return QVariant{};
+}
+
+QHash<int, QByteArray> CommentsModel::roleNames() const {
+    return {
+        {AuthorRole, "author"},
+        {BodyRole, "body"},
+        {CreatedRole, "created"},
+        {UpdatedRole, "updated"}
+    };
+}
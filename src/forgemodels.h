@@ -0,0 +1,121 @@
+#ifndef FORGEMODELS_H
+#define FORGEMODELS_H
+
+#include "pagedmodel.h"
+
+#include <QMetaType>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+// Items fetched from forges. Times are stored as milliseconds since
+// epoch and formatted only when shown.
+
+struct IssueItem {
+    QString number;
+    QString author;
+    QString title;
+    int     comments_count{0};
+    qint64  created{0};
+    qint64  updated{0};
+};
+
+struct ReleaseItem {
+    QString id;
+    QString name;
+    qint64  datetime{0};
+};
+
+struct CommentItem {
+    QString author;
+    QString body;
+    qint64  created{0};
+    qint64  updated{0};
+};
+
+using Discussion = QVector<CommentItem>;
+Q_DECLARE_METATYPE(Discussion)
+
+// page of items together with the cursor of the next page
+template <typename T>
+struct ItemsPage {
+    QVector<T> items;
+    QString    next_cursor;
+};
+
+using IssuesPage = ItemsPage<IssueItem>;
+using ReleasesPage = ItemsPage<ReleaseItem>;
+
+class DateFormatter
+{
+public:
+    static qint64  parse(const QString &txt);
+    static QString format(qint64 msecs, bool short_format);
+};
+
+class IssuesModel : public PagedListModel<IssueItem>
+{
+public:
+    enum Role {
+        IdRole = Qt::UserRole + 1,
+        AuthorRole,
+        CommentsCountRole,
+        NumberRole,
+        TitleRole,
+        CreatedRole,
+        UpdatedRole
+    };
+
+    explicit IssuesModel(QObject *parent = nullptr);
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+};
+
+class ReleasesModel : public PagedListModel<ReleaseItem>
+{
+public:
+    enum Role {
+        IdRole = Qt::UserRole + 1,
+        NameRole,
+        DatetimeRole
+    };
+
+    explicit ReleasesModel(QObject *parent = nullptr);
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+};
+
+/// Comments of an issue, given as discussion value of the issue details
+class CommentsModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QVariant discussion READ discussion WRITE setDiscussion NOTIFY discussionChanged)
+
+public:
+    enum Role {
+        AuthorRole = Qt::UserRole + 1,
+        BodyRole,
+        CreatedRole,
+        UpdatedRole
+    };
+
+    explicit CommentsModel(QObject *parent = nullptr);
+
+    QVariant discussion() const { return QVariant::fromValue(m_items); }
+    void setDiscussion(const QVariant &discussion);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+signals:
+    void discussionChanged();
+
+private:
+    Discussion m_items;
+};
+
+#endif // FORGEMODELS_H
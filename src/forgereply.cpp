@@ -0,0 +1,306 @@
+#include "forgereply.h"
+#include "main.h"
+#include "performanceprofile.h"
+
+#include <QDateTime>
+#include <QTimer>
+
+#include <cstring>
+
+// upper bounds of latency histogram buckets, the last bucket is unbounded
+static const QVector<int> s_buckets_ms{100, 250, 500, 1000, 2500, 5000, 10000, 30000};
+// number of requests before the hedging delay follows the observed latency
+static const int s_hedge_min_samples{20};
+
+QHash<QString, ForgeReply::Statistics> ForgeReply::s_statistics;
+int ForgeReply::s_limited_running{0};
+QList<QPointer<ForgeReply>> ForgeReply::s_limited_queue;
+
+RequestPolicy RequestPolicy::interactive() {
+    RequestPolicy p;
+    p.timeout_ms = 15000;
+    p.retries = 2;
+    p.hedge_after_ms = 2500;
+    return p;
+}
+
+RequestPolicy RequestPolicy::background() {
+    RequestPolicy p;
+    p.timeout_ms = 30000;
+    p.retries = 3;
+    p.backoff_ms = 1000;
+    p.limited = true;
+    return p;
+}
+
+ForgeReply::ForgeReply(QNetworkAccessManager::Operation op, const QNetworkRequest &request,
+                       const QByteArray &data, const QString &backend, const RequestPolicy &policy)
+    : QNetworkReply{nMng},
+      m_outgoing{data},
+      m_backend{backend},
+      m_policy{policy}
+{
+    setOperation(op);
+    setRequest(request);
+    setUrl(request.url());
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    static bool seeded = false;
+    if (!seeded) {
+        qsrand(uint(QDateTime::currentMSecsSinceEpoch()));
+        seeded = true;
+    }
+
+    // limited requests wait until others finish
+    if (m_policy.limited &&
+            s_limited_running >= PerformanceProfile::instance()->hydrationConcurrency())
+        s_limited_queue.append(this);
+    else
+        start();
+}
+
+ForgeReply::~ForgeReply() {
+    abortAttempts();
+    release();
+}
+
+void ForgeReply::start() {
+    if (m_policy.limited) {
+        m_counted = true;
+        ++s_limited_running;
+    }
+    m_started = QDateTime::currentMSecsSinceEpoch();
+    startAttempt(false);
+}
+
+// starts the next waiting request when a limited one is done
+void ForgeReply::release() {
+    if (!m_counted) return;
+    m_counted = false;
+    --s_limited_running;
+    while (!s_limited_queue.isEmpty() &&
+           s_limited_running < PerformanceProfile::instance()->hydrationConcurrency()) {
+        QPointer<ForgeReply> next = s_limited_queue.takeFirst();
+        if (next && !next->m_done)
+            next->start();
+    }
+}
+
+ForgeReply* ForgeReply::get(const QNetworkRequest &request, const QString &backend,
+                            const RequestPolicy &policy) {
+    return new ForgeReply(QNetworkAccessManager::GetOperation, request, QByteArray{}, backend, policy);
+}
+
+ForgeReply* ForgeReply::post(const QNetworkRequest &request, const QByteArray &data,
+                             const QString &backend, const RequestPolicy &policy) {
+    return new ForgeReply(QNetworkAccessManager::PostOperation, request, data, backend, policy);
+}
+
+ForgeReply::Statistics& ForgeReply::stats() {
+    return s_statistics[m_backend + QLatin1Char('/') + url().host()];
+}
+
+void ForgeReply::startAttempt(bool hedge) {
+    if (m_done) return;
+
+    QNetworkReply *reply = operation() == QNetworkAccessManager::PostOperation ?
+                nMng->post(request(), m_outgoing) : nMng->get(request());
+    // timers below refer to the attempt by its serial number, as a later
+    // attempt may get the address of a deleted reply
+    const int serial = ++m_serial;
+    m_attempts.append(Attempt{reply, serial, hedge, false});
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { this->attemptFinished(reply); });
+
+    // abort hanging attempts, the reply finishes with an error then
+    QTimer::singleShot(m_policy.timeout_ms, this, [this, serial]() {
+        for (Attempt &a: m_attempts)
+            if (a.serial == serial) {
+                a.timed_out = true;
+                a.reply->abort();
+                return;
+            }
+    });
+
+    // duplicate a slow attempt while it is running
+    const int hedge_delay = hedgeDelay();
+    if (!hedge && !m_hedged && hedge_delay > 0)
+        QTimer::singleShot(hedge_delay, this, [this, serial]() {
+            if (m_done || m_hedged) return;
+            bool running = false;
+            for (const Attempt &a: m_attempts)
+                running = running || a.serial == serial;
+            if (!running) return;
+            m_hedged = true;
+            ++stats().hedges;
+            this->startAttempt(true);
+        });
+}
+
+void ForgeReply::attemptFinished(QNetworkReply *reply) {
+    bool timed_out = false;
+    bool hedge = false;
+    for (int i = 0; i < m_attempts.size(); ++i)
+        if (m_attempts[i].reply == reply) {
+            timed_out = m_attempts[i].timed_out;
+            hedge = m_attempts[i].hedge;
+            m_attempts.removeAt(i);
+            break;
+        }
+    reply->deleteLater();
+    if (m_done) return;
+
+    if (timed_out) ++stats().timeouts;
+
+    if (reply->error() == QNetworkReply::NoError) {
+        if (hedge) ++stats().hedge_wins;
+        finishWith(reply, false);
+        return;
+    }
+
+    // another attempt is still running
+    if (!m_attempts.isEmpty()) return;
+
+    if (retryable(reply) && m_retries < m_policy.retries) {
+        // full jitter between half and the whole exponential delay
+        const int delay = m_policy.backoff_ms * (1 << m_retries);
+        const int jittered = delay / 2 + qrand() % (delay / 2 + 1);
+        ++m_retries;
+        ++stats().retries;
+        m_hedged = false;
+        QTimer::singleShot(jittered, this, [this]() { this->startAttempt(false); });
+        return;
+    }
+
+    finishWith(reply, timed_out);
+}
+
+bool ForgeReply::retryable(QNetworkReply *reply) const {
+    switch (reply->error()) {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::HostNotFoundError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::OperationCanceledError: // aborted after timeout
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::UnknownNetworkError:
+    case QNetworkReply::InternalServerError:
+    case QNetworkReply::ServiceUnavailableError:
+    case QNetworkReply::UnknownServerError:
+        return true;
+    default:
+        // rate limiting is reported as client error
+        return reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 429;
+    }
+}
+
+int ForgeReply::hedgeDelay() const {
+    if (m_policy.hedge_after_ms <= 0) return 0;
+
+    // hedge at the 90th percentile of the observed latency
+    const Statistics s = s_statistics.value(m_backend + QLatin1Char('/') + url().host());
+    if (s.requests < s_hedge_min_samples) return m_policy.hedge_after_ms;
+    qint64 count = 0;
+    for (int i = 0; i < s.histogram.size() && i < s_buckets_ms.size(); ++i) {
+        count += s.histogram.at(i);
+        if (count*10 >= s.requests*9)
+            return qBound(m_policy.hedge_after_ms, s_buckets_ms.at(i), m_policy.timeout_ms);
+    }
+    return m_policy.timeout_ms; // slower than all buckets, hedging does not help
+}
+
+void ForgeReply::abortAttempts() {
+    for (const Attempt &a: m_attempts) {
+        a.reply->disconnect(this);
+        a.reply->abort();
+        a.reply->deleteLater();
+    }
+    m_attempts.clear();
+}
+
+void ForgeReply::finishWith(QNetworkReply *reply, bool timed_out) {
+    m_done = true;
+    abortAttempts();
+    release();
+
+    // latency of the whole request, including retries
+    const qint64 latency = QDateTime::currentMSecsSinceEpoch() - m_started;
+    Statistics &s = stats();
+    if (s.histogram.isEmpty())
+        s.histogram.fill(0, s_buckets_ms.size() + 1);
+    int bucket = 0;
+    while (bucket < s_buckets_ms.size() && latency > s_buckets_ms.at(bucket)) ++bucket;
+    ++s.histogram[bucket];
+    ++s.requests;
+
+    for (const auto &h: reply->rawHeaderPairs())
+        setRawHeader(h.first, h.second);
+    setAttribute(QNetworkRequest::HttpStatusCodeAttribute,
+                 reply->attribute(QNetworkRequest::HttpStatusCodeAttribute));
+    setAttribute(QNetworkRequest::HttpReasonPhraseAttribute,
+                 reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute));
+    m_data = reply->readAll();
+    emit metaDataChanged();
+
+    if (reply->error() != QNetworkReply::NoError) {
+        ++s.errors;
+        if (timed_out)
+            setError(QNetworkReply::TimeoutError, QStringLiteral("Request timed out"));
+        else
+            setError(reply->error(), reply->errorString());
+        emit error(QNetworkReply::error());
+    }
+
+    if (!m_data.isEmpty())
+        emit readyRead();
+    setFinished(true);
+    emit finished();
+}
+
+void ForgeReply::abort() {
+    if (m_done) return;
+    m_done = true;
+    abortAttempts();
+    release();
+    setError(QNetworkReply::OperationCanceledError, QStringLiteral("Operation canceled"));
+    emit error(QNetworkReply::OperationCanceledError);
+    setFinished(true);
+    emit finished();
+}
+
+qint64 ForgeReply::bytesAvailable() const {
+    return m_data.size() - m_offset + QIODevice::bytesAvailable();
+}
+
+qint64 ForgeReply::readData(char *data, qint64 max_size) {
+    const qint64 n = qMin(max_size, qint64(m_data.size()) - m_offset);
+    if (n <= 0) return m_done ? -1 : 0;
+    std::memcpy(data, m_data.constData() + m_offset, size_t(n));
+    m_offset += n;
+    return n;
+}
+
+// static
+QVariantMap ForgeReply::statistics() {
+    QVariantList buckets;
+    for (int b: s_buckets_ms) buckets.append(b);
+
+    QVariantMap result;
+    for (auto it = s_statistics.constBegin(); it != s_statistics.constEnd(); ++it) {
+        const Statistics &s = it.value();
+        QVariantList histogram;
+        for (qint64 c: s.histogram) histogram.append(c);
+        result.insert(it.key(), QVariantMap{
+                          {QStringLiteral("bucketsMs"), buckets},
+                          {QStringLiteral("histogram"), histogram},
+                          {QStringLiteral("requests"), s.requests},
+                          {QStringLiteral("errors"), s.errors},
+                          {QStringLiteral("timeouts"), s.timeouts},
+                          {QStringLiteral("retries"), s.retries},
+                          {QStringLiteral("hedges"), s.hedges},
+                          {QStringLiteral("hedgeWins"), s.hedge_wins}
+                      });
+    }
+    return result;
+}
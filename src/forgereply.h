@@ -0,0 +1,104 @@
+#ifndef FORGEREPLY_H
+#define FORGEREPLY_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QVariantMap>
+#include <QVector>
+
+/// Timeout, retry and hedging policy of forge requests
+struct RequestPolicy {
+    int  timeout_ms{15000};  // per attempt
+    int  retries{2};         // further attempts after failures, idempotent requests only
+    int  backoff_ms{500};    // base delay before a retry, doubled per retry and jittered
+    int  hedge_after_ms{0};  // duplicate a slow attempt after this delay, 0 disables hedging
+    bool limited{false};     // number of running requests is limited by the performance profile
+
+    // requests for views shown to the user
+    static RequestPolicy interactive();
+    // requests filling in details in the background
+    static RequestPolicy background();
+};
+
+/// Reply of a forge request sent with a request policy. The request is
+/// sent in attempts which are aborted after a timeout and retried with
+/// jittered exponential backoff on network and server errors. A slow
+/// attempt can be hedged by a duplicate request, the first successful
+/// response is used. Finishes once, with the data and error of the
+/// successful or the last failed attempt. Latency of the requests is
+/// collected per backend and host. Used from the main thread only.
+class ForgeReply : public QNetworkReply
+{
+    Q_OBJECT
+public:
+    static ForgeReply* get(const QNetworkRequest &request, const QString &backend,
+                           const RequestPolicy &policy);
+    static ForgeReply* post(const QNetworkRequest &request, const QByteArray &data,
+                            const QString &backend, const RequestPolicy &policy);
+    ~ForgeReply() override;
+
+    void   abort() override;
+    qint64 bytesAvailable() const override;
+    bool   isSequential() const override { return true; }
+
+    // latency histograms and outcomes per backend and host
+    static QVariantMap statistics();
+
+protected:
+    qint64 readData(char *data, qint64 max_size) override;
+
+private:
+    struct Statistics {
+        QVector<qint64> histogram; // requests per latency bucket
+        qint64 requests{0};
+        qint64 errors{0};
+        qint64 timeouts{0};
+        qint64 retries{0};
+        qint64 hedges{0};
+        qint64 hedge_wins{0};
+    };
+
+    ForgeReply(QNetworkAccessManager::Operation op, const QNetworkRequest &request,
+               const QByteArray &data, const QString &backend, const RequestPolicy &policy);
+
+    void start();
+    void release();
+    void startAttempt(bool hedge);
+    void attemptFinished(QNetworkReply *attempt);
+    void finishWith(QNetworkReply *attempt, bool timed_out);
+    bool retryable(QNetworkReply *attempt) const;
+    int  hedgeDelay() const;
+    void abortAttempts();
+    Statistics& stats();
+
+private:
+    struct Attempt {
+        QNetworkReply *reply;
+        int            serial;
+        bool           hedge;
+        bool           timed_out;
+    };
+
+    QByteArray     m_data;
+    qint64         m_offset{0};
+    QByteArray     m_outgoing;
+    QString        m_backend;
+    RequestPolicy  m_policy;
+    QList<Attempt> m_attempts;
+    qint64         m_started{0};
+    int            m_serial{0}; // of the last attempt
+    int            m_retries{0};
+    bool           m_hedged{false};
+    bool           m_done{false};
+    bool           m_counted{false}; // running as limited request
+
+    static QHash<QString, Statistics> s_statistics;
+    static int                        s_limited_running;
+    static QList<QPointer<ForgeReply>> s_limited_queue;
+};
+
+#endif // FORGEREPLY_H
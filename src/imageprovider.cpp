@@ -0,0 +1,336 @@
+#include "imageprovider.h"
+#include "networkmanager.h"
+#include "performanceprofile.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QUrl>
+
+#include <memory>
+#include <utime.h>
+
+// number of decoding threads, size of the memory cache is set by the performance profile
+static const int s_max_threads{3};
+static const int s_download_timeout{30*1000};
+// downloaded images are checked for changes on the server after a week
+static const qint64 s_revalidate_secs{7*24*3600};
+// the disk cache is trimmed below its limit, so that it is not scanned on every write
+static const qreal s_disk_trim_ratio{0.8};
+// validators of a downloaded image are stored next to it in this file
+static const QString s_meta_suffix{QStringLiteral(".meta")};
+
+//////////////////////////////////////////////////////
+/// helper functions
+
+static QString urlHash(const QString &url) {
+    return QString::fromLatin1(QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+// marks the file as recently used for trimming of the disk cache
+static void touch(const QString &path) {
+    ::utime(QFile::encodeName(path).constData(), nullptr);
+}
+
+static QString sizeSuffix(const QSize &size) {
+    if (!size.isValid() || size.isEmpty()) return QStringLiteral("orig");
+    return QStringLiteral("%1x%2").arg(size.width()).arg(size.height());
+}
+
+static QImage decode(QIODevice *device, const QSize &requestedSize, int max_size = 0) {
+    QImageReader reader(device);
+    reader.setAutoTransform(true);
+    const QSize size = reader.size();
+    QSize scaled = size;
+    if (requestedSize.isValid() && !requestedSize.isEmpty())
+        // keep aspect ratio and cover requested size, as needed for PreserveAspectCrop
+        scaled = size.scaled(requestedSize, Qt::KeepAspectRatioByExpanding);
+    if (max_size > 0 && (scaled.width() > max_size || scaled.height() > max_size))
+        scaled = scaled.scaled(max_size, max_size, Qt::KeepAspectRatio);
+    // images are only scaled down
+    if (size.isValid() && scaled.width() < size.width())
+        reader.setScaledSize(scaled);
+    return reader.read();
+}
+
+//////////////////////////////////////////////////////
+/// ImageProvider
+
+ImageProvider *ImageProvider::s_instance{nullptr};
+
+ImageProvider::ImageProvider()
+{
+    m_pool.setMaxThreadCount(s_max_threads);
+    m_cache.setMaxCost(PerformanceProfile::instance()->imageCacheKb());
+    m_disk_max = PerformanceProfile::instance()->imageDiskCacheBytes();
+    QDir().mkpath(cacheDir());
+    s_instance = this;
+}
+
+ImageProvider::~ImageProvider() {
+    if (s_instance == this) s_instance = nullptr;
+}
+
+// static
+QString ImageProvider::cacheDir() {
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+            QStringLiteral("/sailfishos-chum-gui/images");
+}
+
+QQuickImageResponse* ImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize) {
+    ImageResponse *response = new ImageResponse(this, QUrl::fromPercentEncoding(id.toUtf8()), requestedSize);
+    m_pool.start(response);
+    return response;
+}
+
+QImage ImageProvider::cached(const QString &key) {
+    QMutexLocker lock(&m_mutex);
+    QImage *image = m_cache.object(key);
+    return image ? *image : QImage{};
+}
+
+void ImageProvider::insert(const QString &key, const QImage &image) {
+    QMutexLocker lock(&m_mutex);
+    m_cache.insert(key, new QImage(image), qMax(1, image.byteCount() / 1024));
+}
+
+void ImageProvider::clearMemoryCache() {
+    QMutexLocker lock(&m_mutex);
+    m_cache.clear();
+}
+
+void ImageProvider::setMemoryCacheKb(int kb) {
+    QMutexLocker lock(&m_mutex);
+    m_cache.setMaxCost(kb);
+}
+
+qint64 ImageProvider::memoryCacheBytes() {
+    QMutexLocker lock(&m_mutex);
+    return qint64(m_cache.totalCost()) * 1024;
+}
+
+void ImageProvider::setDiskCacheBytes(qint64 bytes) {
+    QMutexLocker lock(&m_disk_mutex);
+    m_disk_max = bytes;
+    if (m_disk_bytes > m_disk_max) trimDiskCache();
+}
+
+void ImageProvider::diskCacheWritten(qint64 bytes) {
+    QMutexLocker lock(&m_disk_mutex);
+    if (m_disk_bytes >= 0) m_disk_bytes += bytes;
+    // the cache is scanned on the first write after start
+    if (m_disk_bytes < 0 || m_disk_bytes > m_disk_max) trimDiskCache();
+}
+
+// Removes files least recently used until the cache is well below its
+// limit. Files are touched when read, so modification time gives the order.
+void ImageProvider::trimDiskCache() {
+    const QFileInfoList files = QDir(cacheDir()).entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+    qint64 total = 0;
+    for (const QFileInfo &f: files) total += f.size();
+
+    if (total > m_disk_max) {
+        const qint64 target = qint64(m_disk_max * s_disk_trim_ratio);
+        for (const QFileInfo &f: files) {
+            if (total <= target) break;
+            if (!QFile::remove(f.absoluteFilePath())) continue;
+            total -= f.size();
+        }
+    }
+    m_disk_bytes = total;
+}
+
+//////////////////////////////////////////////////////
+/// ImageResponse
+
+ImageResponse::ImageResponse(ImageProvider *provider, const QString &url, const QSize &requestedSize)
+    : m_provider(provider),
+      m_url(url),
+      m_requested_size(requestedSize)
+{
+    // limit of decoded size, also for images requested in original size
+    m_max_size = PerformanceProfile::instance()->maxImageSize();
+
+    // deleted by the QML engine
+    setAutoDelete(false);
+}
+
+QQuickTextureFactory* ImageResponse::textureFactory() const {
+    return QQuickTextureFactory::textureFactoryForImage(m_image);
+}
+
+void ImageResponse::run() {
+    if (!m_cancelled)
+        m_image = load();
+    if (m_image.isNull() && m_error.isEmpty())
+        m_error = QStringLiteral("Failed to load image %1").arg(m_url);
+    emit finished();
+}
+
+QImage ImageResponse::load() {
+    const QString hash = urlHash(m_url);
+    QString key = hash + QLatin1Char('_') + sizeSuffix(m_requested_size);
+    if (m_max_size > 0)
+        key += QStringLiteral("_max%1").arg(m_max_size);
+
+    // memory
+    QImage image = m_provider->cached(key);
+    if (!image.isNull()) return image;
+
+    const QString dir = ImageProvider::cacheDir();
+    const QString thumbnail = dir + QLatin1Char('/') + key + QStringLiteral(".png");
+    const QString original = dir + QLatin1Char('/') + hash;
+
+    // copies on disk are replaced if the image was changed on the server
+    QByteArray data;
+    if (QFile::exists(thumbnail) || QFile::exists(original))
+        data = revalidate(original);
+
+    // scaled thumbnail on disk
+    QFile thumbfile(thumbnail);
+    if (data.isEmpty() && thumbfile.open(QIODevice::ReadOnly)) {
+        image = decode(&thumbfile, QSize{});
+        if (!image.isNull()) {
+            touch(thumbnail);
+            m_provider->insert(key, image);
+            return image;
+        }
+    }
+
+    // original on disk or from network
+    QFile origfile(original);
+    if (!data.isEmpty()) {
+        // revalidated
+    } else if (origfile.open(QIODevice::ReadOnly)) {
+        data = origfile.readAll();
+        touch(original);
+    } else {
+        Validators validators;
+        data = download(validators);
+        if (data.isEmpty() || m_cancelled) return QImage{};
+        store(original, data, validators);
+    }
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    image = decode(&buffer, m_requested_size, m_max_size);
+    if (image.isNull()) return image;
+
+    if (sizeSuffix(m_requested_size) != QLatin1String("orig") && image.save(thumbnail, "PNG"))
+        m_provider->diskCacheWritten(QFileInfo(thumbnail).size());
+    m_provider->insert(key, image);
+    return image;
+}
+
+// Checks copies on disk with the server once they are older than a week.
+// Returns the downloaded image if it was changed, all its thumbnails are
+// removed then. If it is unchanged or the server cannot be reached, the
+// copies are used for another week.
+QByteArray ImageResponse::revalidate(const QString &original) {
+    const QString metafile = original + s_meta_suffix;
+    Validators validators;
+    QFile meta(metafile);
+    if (meta.open(QIODevice::ReadOnly)) {
+        const qint64 validated = meta.readLine().trimmed().toLongLong();
+        validators.etag = meta.readLine().trimmed();
+        validators.last_modified = meta.readLine().trimmed();
+        meta.close();
+        if (QDateTime::currentMSecsSinceEpoch()/1000 - validated < s_revalidate_secs) {
+            touch(metafile);
+            return QByteArray{};
+        }
+    }
+
+    bool not_modified = false;
+    const QByteArray data = download(validators, &not_modified);
+    if (m_cancelled) return QByteArray{};
+    if (data.isEmpty()) {
+        m_error.clear(); // cached copies are used
+        store(original, QByteArray{}, validators);
+        return QByteArray{};
+    }
+
+    const QString hash = QFileInfo(original).fileName();
+    QDir dir(ImageProvider::cacheDir());
+    for (const QString &f: dir.entryList({hash + QStringLiteral("_*.png")}, QDir::Files))
+        dir.remove(f);
+    store(original, data, validators);
+    return data;
+}
+
+// Downloads the image, conditionally if validators are given. Validators
+// are updated from the response.
+QByteArray ImageResponse::download(Validators &validators, bool *not_modified) {
+    // network access manager per worker thread, as it cannot be shared between threads.
+    // Images are kept in the disk cache of the provider, not in the one of the network stack.
+    static thread_local std::unique_ptr<QNetworkAccessManager> manager;
+    if (!manager) manager.reset(new NetworkManager(false));
+
+    QNetworkRequest request{QUrl(m_url)};
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    if (!validators.etag.isEmpty())
+        request.setRawHeader("If-None-Match", validators.etag);
+    if (!validators.last_modified.isEmpty())
+        request.setRawHeader("If-Modified-Since", validators.last_modified);
+    QNetworkReply *reply = manager->get(request);
+
+    QEventLoop loop;
+    QTimer::singleShot(s_download_timeout, &loop, &QEventLoop::quit);
+    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    QByteArray data;
+    if (!reply->isFinished()) {
+        m_error = QStringLiteral("Timeout while downloading %1").arg(m_url);
+        reply->abort();
+    } else if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+        if (not_modified) *not_modified = true;
+    } else if (reply->error() != QNetworkReply::NoError) {
+        m_error = reply->errorString();
+        qWarning() << "Failed to download image" << m_url << m_error;
+    } else
+        data = reply->readAll();
+
+    if (reply->isFinished() && reply->error() == QNetworkReply::NoError) {
+        if (reply->hasRawHeader("ETag"))
+            validators.etag = reply->rawHeader("ETag");
+        if (reply->hasRawHeader("Last-Modified"))
+            validators.last_modified = reply->rawHeader("Last-Modified");
+    }
+    delete reply;
+    return data;
+}
+
+// Writes the image, if given, and its validators with the time of validation
+void ImageResponse::store(const QString &original, const QByteArray &data, const Validators &validators) {
+    qint64 written = 0;
+    if (!data.isEmpty()) {
+        QSaveFile out(original);
+        if (out.open(QIODevice::WriteOnly)) {
+            out.write(data);
+            if (out.commit()) written += data.size();
+        }
+    }
+
+    const QByteArray meta = QByteArray::number(QDateTime::currentMSecsSinceEpoch()/1000) + '\n' +
+            validators.etag + '\n' + validators.last_modified + '\n';
+    QSaveFile out(original + s_meta_suffix);
+    if (out.open(QIODevice::WriteOnly)) {
+        out.write(meta);
+        if (out.commit()) written += meta.size();
+    }
+    m_provider->diskCacheWritten(written);
+}
@@ -0,0 +1,89 @@
+#ifndef IMAGEPROVIDER_H
+#define IMAGEPROVIDER_H
+
+#include <QAtomicInt>
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QQuickAsyncImageProvider>
+#include <QQuickImageResponse>
+#include <QRunnable>
+#include <QThreadPool>
+
+/// Image provider for package icons and screenshots, used in QML as
+/// `image://chum/<percent-encoded URL>`. Images are downloaded once into
+/// a persistent disk cache and decoded on worker threads at the
+/// requested size. Scaled images are stored on disk as thumbnails and
+/// kept in a bounded in-memory LRU cache. The disk cache is limited in
+/// size, evicting files least recently used, and downloaded images are
+/// revalidated with the server using ETag or Last-Modified once a week.
+class ImageProvider : public QQuickAsyncImageProvider
+{
+public:
+    ImageProvider();
+    ~ImageProvider() override;
+
+    QQuickImageResponse* requestImageResponse(const QString &id, const QSize &requestedSize) override;
+
+    QImage cached(const QString &key);
+    void   insert(const QString &key, const QImage &image);
+    void   clearMemoryCache();
+    void   setMemoryCacheKb(int kb);
+    qint64 memoryCacheBytes();
+
+    // disk cache of originals and thumbnails, trimmed when files are written
+    void   setDiskCacheBytes(qint64 bytes);
+    void   diskCacheWritten(qint64 bytes);
+
+    static QString cacheDir();
+    // provider registered with the QML engine, nullptr without GUI
+    static ImageProvider* instance() { return s_instance; }
+
+private:
+    QThreadPool           m_pool;
+    QMutex                m_mutex;
+    QCache<QString, QImage> m_cache; // cost in kB
+
+    void   trimDiskCache(); // called with the disk mutex locked
+    QMutex m_disk_mutex;
+    qint64 m_disk_max;
+    qint64 m_disk_bytes{-1}; // unknown until the cache is scanned
+
+    static ImageProvider *s_instance;
+};
+
+class ImageResponse : public QQuickImageResponse, public QRunnable
+{
+    Q_OBJECT
+public:
+    ImageResponse(ImageProvider *provider, const QString &url, const QSize &requestedSize);
+
+    QQuickTextureFactory* textureFactory() const override;
+    QString errorString() const override { return m_error; }
+    void cancel() override { m_cancelled = true; }
+
+    void run() override;
+
+private:
+    // validators of a downloaded image, stored next to it
+    struct Validators {
+        QByteArray etag;
+        QByteArray last_modified;
+    };
+
+    QImage load();
+    QByteArray revalidate(const QString &original);
+    QByteArray download(Validators &validators, bool *not_modified = nullptr);
+    void store(const QString &original, const QByteArray &data, const Validators &validators);
+
+private:
+    ImageProvider *m_provider;
+    QString        m_url;
+    QSize          m_requested_size;
+    int            m_max_size{0};
+    QImage         m_image;
+    QString        m_error;
+    QAtomicInt     m_cancelled{0};
+};
+
+#endif // IMAGEPROVIDER_H
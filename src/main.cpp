@@ -1,8 +1,18 @@
 #include "chum.h"
 #include "chumpackage.h"
 #include "chumpackagesmodel.h"
+#include "forgemodels.h"
+#include "imageprovider.h"
 #include "loadableobject.h"
 #include "main.h"
+#include "markdownrenderer.h"
+#include "networkmanager.h"
+#include "operationprogress.h"
+#include "projectforgejo.h"
+#include "projectgitlab.h"
+#include "stallwatchdog.h"
+#include "tracer.h"
+#include "updatechecker.h"
 #include <sailfishapp.h>
 
 #include <QtQuick>
@@ -10,12 +20,27 @@
 #define CHUM_REGISTER_TYPE(NAME) \
     qmlRegisterType<NAME>("org.chum", 1, 0, #NAME)
 
-QNetworkAccessManager *nMng{nullptr};
-
 int main(int argc, char *argv[]) {
+    // Headless mode: check for updates without starting the GUI
+    for (int i=1; i < argc; ++i)
+        if (qstrcmp(argv[i], "--check-updates") == 0) {
+            QCoreApplication app(argc, argv);
+            UpdateChecker checker;
+            checker.setBackground(app.arguments().contains(QStringLiteral("--background")));
+            QObject::connect(&checker, &UpdateChecker::finished, &app, &QCoreApplication::exit);
+            QTimer::singleShot(0, &checker, &UpdateChecker::start);
+            return app.exec();
+        }
+
     CHUM_REGISTER_TYPE(ChumPackage);
     CHUM_REGISTER_TYPE(ChumPackagesModel);
+    CHUM_REGISTER_TYPE(CommentsModel);
     CHUM_REGISTER_TYPE(LoadableObject);
+    CHUM_REGISTER_TYPE(MarkdownRenderer);
+    qmlRegisterUncreatableType<PagedModel>("org.chum", 1, 0, "PagedModel",
+                                           QStringLiteral("PagedModel is provided by ChumPackage"));
+    qmlRegisterUncreatableType<OperationProgress>("org.chum", 1, 0, "OperationProgress",
+                                                  QStringLiteral("OperationProgress is provided by Chum"));
 
     qmlRegisterSingletonType<Chum>("org.chum", 1, 0, "Chum", [](QQmlEngine *, QJSEngine *) -> QObject * {
         return static_cast<QObject *>(Chum::instance());
@@ -24,9 +49,43 @@ int main(int argc, char *argv[]) {
     SailfishApp::application(argc, argv);
     QCoreApplication::setApplicationVersion(QStringLiteral(CHUMGUI_VERSION));
 
-    nMng = new QNetworkAccessManager(qApp);
+    // Chrome Trace Event export of refresh stages and network requests
+    QString trace_file = QString::fromLocal8Bit(qgetenv("CHUM_TRACE"));
+    const QStringList args = QCoreApplication::arguments();
+    const int trace_arg = args.indexOf(QStringLiteral("--trace"));
+    if (trace_arg >= 0 && trace_arg + 1 < args.size())
+        trace_file = args.at(trace_arg + 1);
+    if (!trace_file.isEmpty()) {
+        Tracer::instance()->setFileName(trace_file);
+        QObject::connect(qApp, &QCoreApplication::aboutToQuit, []() { Tracer::instance()->save(); });
+    }
+
+    // Event loop stall statistics and other diagnostics written on exit
+    QString diagnostics_file = QString::fromLocal8Bit(qgetenv("CHUM_DIAGNOSTICS"));
+    const int diagnostics_arg = args.indexOf(QStringLiteral("--diagnostics"));
+    if (diagnostics_arg >= 0 && diagnostics_arg + 1 < args.size())
+        diagnostics_file = args.at(diagnostics_arg + 1);
+    if (!diagnostics_file.isEmpty())
+        QObject::connect(qApp, &QCoreApplication::aboutToQuit, [diagnostics_file]() {
+            Chum::instance()->saveDiagnostics(diagnostics_file);
+        });
+
+    // Stall detection wakes up the CPU periodically, only used when its
+    // results are written
+    if (!diagnostics_file.isEmpty() || Tracer::instance()->enabled()) {
+        StallWatchdog::instance()->setEnabled(true);
+        StallWatchdog::instance()->start();
+        QObject::connect(qApp, &QCoreApplication::aboutToQuit, []() { StallWatchdog::instance()->stop(); });
+    }
+
+    NetworkManager *network = new NetworkManager(true, qApp);
+    network->prewarm(QStringList{QStringLiteral("api.github.com")} +
+                     ProjectGitLab::hosts() + ProjectForgejo::hosts());
+    nMng = network;
 
     QQuickView v;
+    v.engine()->setNetworkAccessManagerFactory(new NetworkManagerFactory);
+    v.engine()->addImageProvider(QStringLiteral("chum"), new ImageProvider);
     v.setSource(SailfishApp::pathToMainQml());
     v.show();
 
@@ -0,0 +1,574 @@
+#include "markdownrenderer.h"
+#include "main.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QThreadPool>
+#include <QUrl>
+
+#include <functional>
+#include <utime.h>
+
+// rendered documents kept on disk, trimmed below the limit when exceeded
+static const qint64 s_cache_max_bytes{4*1024*1024};
+static const qreal s_cache_trim_ratio{0.8};
+
+//////////////////////////////////////////////////////
+/// Markdown to rich text conversion
+///
+/// Supports the subset of Markdown used in package descriptions with the
+/// options used earlier with showdown: headings, paragraphs with simple
+/// line breaks, emphasis, strikethrough, inline and block code, block
+/// quotes, nested lists, tables, links, images with dimensions
+/// (`![alt](url =100x80)`, `*` for automatic), automatic links, inline
+/// HTML and emoji shortcodes. Only commonly used GitHub shortcodes are
+/// known, others are kept as written.
+
+static QString escapeHtml(const QString &txt, bool keep_tags) {
+    static const QRegularExpression entity(QStringLiteral("&(#\\d+|#x[0-9a-fA-F]+|[A-Za-z]+);"));
+    QString out;
+    out.reserve(txt.size());
+    for (int i=0; i < txt.size(); ++i) {
+        const QChar c = txt.at(i);
+        if (c == QLatin1Char('&') && !(keep_tags && entity.match(txt, i, QRegularExpression::NormalMatch,
+                                                                        QRegularExpression::AnchoredMatchOption).hasMatch()))
+            out += QLatin1String("&amp;");
+        else if (c == QLatin1Char('<') &&
+                 !(keep_tags && i+1 < txt.size() &&
+                   (txt.at(i+1).isLetter() || txt.at(i+1) == QLatin1Char('/') || txt.at(i+1) == QLatin1Char('!'))))
+            out += QLatin1String("&lt;");
+        else if (c == QLatin1Char('>') && !keep_tags)
+            out += QLatin1String("&gt;");
+        else
+            out += c;
+    }
+    return out;
+}
+
+// Value of an HTML attribute in double quotes, in text escaped already
+// with kept tags
+static QString escapeAttribute(const QString &value) {
+    QString out = escapeHtml(value, true);
+    out.replace(QLatin1Char('<'), QLatin1String("&lt;"));
+    out.replace(QLatin1Char('>'), QLatin1String("&gt;"));
+    out.replace(QLatin1Char('"'), QLatin1String("&quot;"));
+    return out;
+}
+
+static QString replaceMatches(const QString &txt, const QRegularExpression &re,
+                              std::function<QString(const QRegularExpressionMatch &)> replacement) {
+    QString out;
+    int last = 0;
+    auto it = re.globalMatch(txt);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch m = it.next();
+        out += txt.midRef(last, m.capturedStart() - last);
+        out += replacement(m);
+        last = m.capturedEnd();
+    }
+    out += txt.midRef(last);
+    return out;
+}
+
+// Replaces matches by placeholders, protecting them from further inline processing
+static QString protect(const QString &txt, const QRegularExpression &re, QStringList &stash,
+                       std::function<QString(const QRegularExpressionMatch &)> replacement) {
+    return replaceMatches(txt, re, [&stash, replacement](const QRegularExpressionMatch &m) {
+        stash.append(replacement(m));
+        return QChar(0xE000) + QString::number(stash.size() - 1) + QChar(0xE001);
+    });
+}
+
+// Commonly used GitHub emoji shortcodes
+static const QHash<QString, QString> &emojis() {
+    static const QHash<QString, QString> table{
+        {QStringLiteral("smile"), QStringLiteral("\U0001F604")},
+        {QStringLiteral("smiley"), QStringLiteral("\U0001F603")},
+        {QStringLiteral("grinning"), QStringLiteral("\U0001F600")},
+        {QStringLiteral("grin"), QStringLiteral("\U0001F601")},
+        {QStringLiteral("laughing"), QStringLiteral("\U0001F606")},
+        {QStringLiteral("joy"), QStringLiteral("\U0001F602")},
+        {QStringLiteral("wink"), QStringLiteral("\U0001F609")},
+        {QStringLiteral("blush"), QStringLiteral("\U0001F60A")},
+        {QStringLiteral("slightly_smiling_face"), QStringLiteral("\U0001F642")},
+        {QStringLiteral("heart_eyes"), QStringLiteral("\U0001F60D")},
+        {QStringLiteral("sunglasses"), QStringLiteral("\U0001F60E")},
+        {QStringLiteral("thinking"), QStringLiteral("\U0001F914")},
+        {QStringLiteral("neutral_face"), QStringLiteral("\U0001F610")},
+        {QStringLiteral("confused"), QStringLiteral("\U0001F615")},
+        {QStringLiteral("cry"), QStringLiteral("\U0001F622")},
+        {QStringLiteral("sob"), QStringLiteral("\U0001F62D")},
+        {QStringLiteral("angry"), QStringLiteral("\U0001F620")},
+        {QStringLiteral("scream"), QStringLiteral("\U0001F631")},
+        {QStringLiteral("sweat_smile"), QStringLiteral("\U0001F605")},
+        {QStringLiteral("innocent"), QStringLiteral("\U0001F607")},
+        {QStringLiteral("upside_down_face"), QStringLiteral("\U0001F643")},
+        {QStringLiteral("+1"), QStringLiteral("\U0001F44D")},
+        {QStringLiteral("thumbsup"), QStringLiteral("\U0001F44D")},
+        {QStringLiteral("-1"), QStringLiteral("\U0001F44E")},
+        {QStringLiteral("thumbsdown"), QStringLiteral("\U0001F44E")},
+        {QStringLiteral("ok_hand"), QStringLiteral("\U0001F44C")},
+        {QStringLiteral("clap"), QStringLiteral("\U0001F44F")},
+        {QStringLiteral("wave"), QStringLiteral("\U0001F44B")},
+        {QStringLiteral("pray"), QStringLiteral("\U0001F64F")},
+        {QStringLiteral("muscle"), QStringLiteral("\U0001F4AA")},
+        {QStringLiteral("point_right"), QStringLiteral("\U0001F449")},
+        {QStringLiteral("point_left"), QStringLiteral("\U0001F448")},
+        {QStringLiteral("point_up"), QStringLiteral("\u261D\uFE0F")},
+        {QStringLiteral("point_down"), QStringLiteral("\U0001F447")},
+        {QStringLiteral("raised_hands"), QStringLiteral("\U0001F64C")},
+        {QStringLiteral("eyes"), QStringLiteral("\U0001F440")},
+        {QStringLiteral("heart"), QStringLiteral("\u2764\uFE0F")},
+        {QStringLiteral("broken_heart"), QStringLiteral("\U0001F494")},
+        {QStringLiteral("star"), QStringLiteral("\u2B50")},
+        {QStringLiteral("sparkles"), QStringLiteral("\u2728")},
+        {QStringLiteral("fire"), QStringLiteral("\U0001F525")},
+        {QStringLiteral("zap"), QStringLiteral("\u26A1")},
+        {QStringLiteral("boom"), QStringLiteral("\U0001F4A5")},
+        {QStringLiteral("tada"), QStringLiteral("\U0001F389")},
+        {QStringLiteral("rocket"), QStringLiteral("\U0001F680")},
+        {QStringLiteral("100"), QStringLiteral("\U0001F4AF")},
+        {QStringLiteral("bulb"), QStringLiteral("\U0001F4A1")},
+        {QStringLiteral("bug"), QStringLiteral("\U0001F41B")},
+        {QStringLiteral("wrench"), QStringLiteral("\U0001F527")},
+        {QStringLiteral("hammer"), QStringLiteral("\U0001F528")},
+        {QStringLiteral("gear"), QStringLiteral("\u2699\uFE0F")},
+        {QStringLiteral("lock"), QStringLiteral("\U0001F512")},
+        {QStringLiteral("unlock"), QStringLiteral("\U0001F513")},
+        {QStringLiteral("key"), QStringLiteral("\U0001F511")},
+        {QStringLiteral("package"), QStringLiteral("\U0001F4E6")},
+        {QStringLiteral("memo"), QStringLiteral("\U0001F4DD")},
+        {QStringLiteral("book"), QStringLiteral("\U0001F4D6")},
+        {QStringLiteral("books"), QStringLiteral("\U0001F4DA")},
+        {QStringLiteral("link"), QStringLiteral("\U0001F517")},
+        {QStringLiteral("mag"), QStringLiteral("\U0001F50D")},
+        {QStringLiteral("bell"), QStringLiteral("\U0001F514")},
+        {QStringLiteral("calendar"), QStringLiteral("\U0001F4C6")},
+        {QStringLiteral("phone"), QStringLiteral("\u260E\uFE0F")},
+        {QStringLiteral("iphone"), QStringLiteral("\U0001F4F1")},
+        {QStringLiteral("computer"), QStringLiteral("\U0001F4BB")},
+        {QStringLiteral("camera"), QStringLiteral("\U0001F4F7")},
+        {QStringLiteral("musical_note"), QStringLiteral("\U0001F3B5")},
+        {QStringLiteral("video_game"), QStringLiteral("\U0001F3AE")},
+        {QStringLiteral("globe_with_meridians"), QStringLiteral("\U0001F310")},
+        {QStringLiteral("earth_africa"), QStringLiteral("\U0001F30D")},
+        {QStringLiteral("sunny"), QStringLiteral("\u2600\uFE0F")},
+        {QStringLiteral("cloud"), QStringLiteral("\u2601\uFE0F")},
+        {QStringLiteral("umbrella"), QStringLiteral("\u2614")},
+        {QStringLiteral("snowflake"), QStringLiteral("\u2744\uFE0F")},
+        {QStringLiteral("coffee"), QStringLiteral("\u2615")},
+        {QStringLiteral("beer"), QStringLiteral("\U0001F37A")},
+        {QStringLiteral("pizza"), QStringLiteral("\U0001F355")},
+        {QStringLiteral("dog"), QStringLiteral("\U0001F436")},
+        {QStringLiteral("cat"), QStringLiteral("\U0001F431")},
+        {QStringLiteral("penguin"), QStringLiteral("\U0001F427")},
+        {QStringLiteral("fish"), QStringLiteral("\U0001F41F")},
+        {QStringLiteral("dolphin"), QStringLiteral("\U0001F42C")},
+        {QStringLiteral("warning"), QStringLiteral("\u26A0\uFE0F")},
+        {QStringLiteral("no_entry"), QStringLiteral("\u26D4")},
+        {QStringLiteral("construction"), QStringLiteral("\U0001F6A7")},
+        {QStringLiteral("white_check_mark"), QStringLiteral("\u2705")},
+        {QStringLiteral("heavy_check_mark"), QStringLiteral("\u2714\uFE0F")},
+        {QStringLiteral("ballot_box_with_check"), QStringLiteral("\u2611\uFE0F")},
+        {QStringLiteral("x"), QStringLiteral("\u274C")},
+        {QStringLiteral("question"), QStringLiteral("\u2753")},
+        {QStringLiteral("exclamation"), QStringLiteral("\u2757")},
+        {QStringLiteral("information_source"), QStringLiteral("\u2139\uFE0F")},
+        {QStringLiteral("arrow_right"), QStringLiteral("\u27A1\uFE0F")},
+        {QStringLiteral("arrow_left"), QStringLiteral("\u2B05\uFE0F")},
+        {QStringLiteral("arrow_up"), QStringLiteral("\u2B06\uFE0F")},
+        {QStringLiteral("arrow_down"), QStringLiteral("\u2B07\uFE0F")},
+        {QStringLiteral("new"), QStringLiteral("\U0001F195")},
+        {QStringLiteral("free"), QStringLiteral("\U0001F193")},
+        {QStringLiteral("copyright"), QStringLiteral("\u00A9\uFE0F")},
+        {QStringLiteral("registered"), QStringLiteral("\u00AE\uFE0F")},
+        {QStringLiteral("tm"), QStringLiteral("\u2122\uFE0F")}
+    };
+    return table;
+}
+
+static QString inlineHtml(const QString &text) {
+    static const QRegularExpression code(QStringLiteral("(`+)(.+?)\\1"));
+    static const QRegularExpression image(QStringLiteral("!\\[([^\\]]*)\\]\\(\\s*<?([^)\\s>]+)>?"
+                                                        "(?:\\s+=(\\d+(?:px|%)?|\\*)x(\\d+(?:px|%)?|\\*))?"
+                                                        "(?:\\s+\"[^\"]*\")?\\s*\\)"));
+    static const QRegularExpression link(QStringLiteral("\\[([^\\]]+)\\]\\(\\s*<?([^)\\s>]+)>?(?:\\s+\"[^\"]*\")?\\s*\\)"));
+    static const QRegularExpression autolink(QStringLiteral("<((?:https?|ftp)://[^>\\s]+)>"));
+    static const QRegularExpression url(QStringLiteral("(?<![\"'=>\\w])((?:https?|ftp)://[^\\s<]*[^\\s<.,:;!?)\\]'\"])"));
+    static const QRegularExpression tag(QStringLiteral("<[^>]+>"));
+    static const QRegularExpression bold(QStringLiteral("(\\*\\*|__)(?=\\S)(.+?)(?<=\\S)\\1"));
+    static const QRegularExpression italic(QStringLiteral("(?<![\\w*])([*_])(?=\\S)(.+?)(?<=\\S)\\1(?![\\w*])"));
+    static const QRegularExpression strike(QStringLiteral("~~(?=\\S)(.+?)(?<=\\S)~~"));
+    static const QRegularExpression emoji(QStringLiteral(":([a-z0-9_+-]+):"));
+    static const QRegularExpression placeholder(QStringLiteral("\\x{E000}(\\d+)\\x{E001}"));
+
+    QStringList stash;
+    QString txt = protect(text, code, stash, [](const QRegularExpressionMatch &m) {
+        return QStringLiteral("<code>%1</code>").arg(escapeHtml(m.captured(2).trimmed(), false));
+    });
+    txt = escapeHtml(txt, true);
+    txt = protect(txt, image, stash, [](const QRegularExpressionMatch &m) {
+        QString img = QStringLiteral("<img src=\"%1\" alt=\"%2\"").arg(escapeAttribute(m.captured(2)),
+                                                                        escapeAttribute(m.captured(1)));
+        // dimensions given as =WxH, pixels are the default unit
+        const QString width = m.captured(3), height = m.captured(4);
+        if (!width.isEmpty() && width != QLatin1String("*"))
+            img += QStringLiteral(" width=\"%1\"").arg(QString(width).remove(QLatin1String("px")));
+        if (!height.isEmpty() && height != QLatin1String("*"))
+            img += QStringLiteral(" height=\"%1\"").arg(QString(height).remove(QLatin1String("px")));
+        return img + QLatin1String(" />");
+    });
+    txt = replaceMatches(txt, link, [](const QRegularExpressionMatch &m) {
+        return QStringLiteral("<a href=\"%1\">%2</a>").arg(escapeAttribute(m.captured(2)), m.captured(1));
+    });
+    auto urlLink = [](const QRegularExpressionMatch &m) {
+        return QStringLiteral("<a href=\"%1\">%2</a>").arg(escapeAttribute(m.captured(1)), m.captured(1));
+    };
+    txt = replaceMatches(txt, autolink, urlLink);
+    txt = replaceMatches(txt, url, urlLink);
+    txt = protect(txt, tag, stash, [](const QRegularExpressionMatch &m) { return m.captured(0); });
+
+    txt = replaceMatches(txt, emoji, [](const QRegularExpressionMatch &m) {
+        return emojis().value(m.captured(1), m.captured(0));
+    });
+
+    txt.replace(bold, QStringLiteral("<b>\\2</b>"));
+    txt.replace(italic, QStringLiteral("<i>\\2</i>"));
+    txt.replace(strike, QStringLiteral("<del>\\1</del>"));
+
+    // restore protected parts, these can be nested
+    for (int pass=0; pass < 3 && txt.contains(QChar(0xE000)); ++pass) {
+        QString out;
+        int last = 0;
+        auto it = placeholder.globalMatch(txt);
+        while (it.hasNext()) {
+            const QRegularExpressionMatch m = it.next();
+            out += txt.midRef(last, m.capturedStart() - last);
+            out += stash.value(m.captured(1).toInt());
+            last = m.capturedEnd();
+        }
+        out += txt.midRef(last);
+        txt = out;
+    }
+    return txt;
+}
+
+static QStringList tableCells(QString line) {
+    line = line.trimmed();
+    if (line.startsWith(QLatin1Char('|'))) line.remove(0, 1);
+    if (line.endsWith(QLatin1Char('|'))) line.chop(1);
+    QStringList cells = line.split(QLatin1Char('|'));
+    for (QString &c: cells) c = c.trimmed();
+    return cells;
+}
+
+static int indentation(const QString &line) {
+    int n = 0;
+    for (const QChar c: line) {
+        if (c == QLatin1Char(' ')) ++n;
+        else if (c == QLatin1Char('\t')) n += 4;
+        else break;
+    }
+    return n;
+}
+
+static QString blocksHtml(const QStringList &lines) {
+    static const QRegularExpression fence(QStringLiteral("^\\s*(```|~~~)"));
+    static const QRegularExpression heading(QStringLiteral("^\\s{0,3}(#{1,6})\\s+(.*?)\\s*#*\\s*$"));
+    static const QRegularExpression setext1(QStringLiteral("^\\s{0,3}=+\\s*$"));
+    static const QRegularExpression setext2(QStringLiteral("^\\s{0,3}-+\\s*$"));
+    static const QRegularExpression rule(QStringLiteral("^\\s{0,3}([-*_])(\\s*\\1){2,}\\s*$"));
+    static const QRegularExpression quote(QStringLiteral("^\\s{0,3}>\\s?(.*)$"));
+    static const QRegularExpression item(QStringLiteral("^(\\s*)([-*+]|\\d+[.)])\\s+(.*)$"));
+    static const QRegularExpression separator(QStringLiteral("^\\s*\\|?\\s*:?-+:?\\s*(\\|\\s*:?-+:?\\s*)*\\|?\\s*$"));
+
+    QString html;
+    QStringList paragraph;
+    struct List { int indent; bool ordered; };
+    QList<List> lists;
+    bool item_open = false;
+
+    auto closeParagraph = [&]() {
+        if (paragraph.isEmpty()) return;
+        const QString content = inlineHtml(paragraph.join(QLatin1Char('\n'))).replace(QLatin1Char('\n'), QLatin1String("<br />"));
+        html += item_open ? content : QStringLiteral("<p>%1</p>\n").arg(content);
+        paragraph.clear();
+    };
+    auto closeLists = [&](int indent) {
+        closeParagraph();
+        while (!lists.isEmpty() && lists.last().indent >= indent) {
+            html += lists.last().ordered ? QLatin1String("</li></ol>\n") : QLatin1String("</li></ul>\n");
+            lists.removeLast();
+        }
+        item_open = !lists.isEmpty();
+    };
+
+    for (int i=0; i < lines.size(); ++i) {
+        const QString &line = lines.at(i);
+        QRegularExpressionMatch m;
+
+        if (line.trimmed().isEmpty()) {
+            closeParagraph();
+            // lists continue over blank lines only if followed by indented or item lines
+            if (!lists.isEmpty() && i+1 < lines.size() &&
+                    !(indentation(lines.at(i+1)) > 0 || item.match(lines.at(i+1)).hasMatch()))
+                closeLists(0);
+            continue;
+        }
+
+        if (fence.match(line).hasMatch()) {
+            closeLists(0);
+            QStringList code;
+            for (++i; i < lines.size() && !fence.match(lines.at(i)).hasMatch(); ++i)
+                code.append(lines.at(i));
+            html += QStringLiteral("<pre>%1</pre>\n").arg(escapeHtml(code.join(QLatin1Char('\n')), false));
+            continue;
+        }
+
+        if (lists.isEmpty() && paragraph.size() == 1 &&
+                (setext1.match(line).hasMatch() || setext2.match(line).hasMatch())) {
+            const int level = setext1.match(line).hasMatch() ? 1 : 2;
+            html += QStringLiteral("<h%1>%2</h%1>\n").arg(level).arg(inlineHtml(paragraph.first()));
+            paragraph.clear();
+            continue;
+        }
+
+        if (rule.match(line).hasMatch()) {
+            closeLists(0);
+            html += QLatin1String("<hr />\n");
+            continue;
+        }
+
+        if ((m = item.match(line)).hasMatch()) {
+            const int indent = indentation(m.captured(1));
+            const bool ordered = m.captured(2).at(0).isDigit();
+            closeParagraph();
+            if (!lists.isEmpty() && lists.last().indent > indent)
+                closeLists(indent + 1);
+            if (lists.isEmpty() || lists.last().indent < indent) {
+                html += ordered ? QLatin1String("<ol><li>") : QLatin1String("<ul><li>");
+                lists.append(List{indent, ordered});
+            } else
+                html += QLatin1String("</li><li>");
+            item_open = true;
+            paragraph.append(m.captured(3));
+            continue;
+        }
+
+        if (!lists.isEmpty() && indentation(line) > lists.last().indent) {
+            paragraph.append(line.trimmed()); // continuation of list item
+            continue;
+        }
+        if (!lists.isEmpty()) closeLists(0);
+
+        if (indentation(line) >= 4 && paragraph.isEmpty()) {
+            QStringList code;
+            for (; i < lines.size() && (indentation(lines.at(i)) >= 4 || lines.at(i).trimmed().isEmpty()); ++i)
+                code.append(lines.at(i).mid(4));
+            --i;
+            while (!code.isEmpty() && code.last().trimmed().isEmpty()) code.removeLast();
+            html += QStringLiteral("<pre>%1</pre>\n").arg(escapeHtml(code.join(QLatin1Char('\n')), false));
+            continue;
+        }
+
+        if ((m = heading.match(line)).hasMatch()) {
+            closeParagraph();
+            const int level = m.captured(1).size();
+            html += QStringLiteral("<h%1>%2</h%1>\n").arg(level).arg(inlineHtml(m.captured(2)));
+            continue;
+        }
+
+        if (quote.match(line).hasMatch()) {
+            closeParagraph();
+            QStringList quoted;
+            for (; i < lines.size() && (m = quote.match(lines.at(i))).hasMatch(); ++i)
+                quoted.append(m.captured(1));
+            --i;
+            html += QStringLiteral("<blockquote>%1</blockquote>\n").arg(blocksHtml(quoted));
+            continue;
+        }
+
+        if (line.contains(QLatin1Char('|')) && i+1 < lines.size() && separator.match(lines.at(i+1)).hasMatch()) {
+            closeParagraph();
+            html += QLatin1String("<table border=\"1\" cellpadding=\"4\"><tr>");
+            for (const QString &c: tableCells(line))
+                html += QStringLiteral("<th>%1</th>").arg(inlineHtml(c));
+            html += QLatin1String("</tr>\n");
+            for (i += 2; i < lines.size() && lines.at(i).contains(QLatin1Char('|')); ++i) {
+                html += QLatin1String("<tr>");
+                for (const QString &c: tableCells(lines.at(i)))
+                    html += QStringLiteral("<td>%1</td>").arg(inlineHtml(c));
+                html += QLatin1String("</tr>\n");
+            }
+            --i;
+            html += QLatin1String("</table>\n");
+            continue;
+        }
+
+        paragraph.append(line.trimmed());
+    }
+
+    closeLists(0);
+    return html;
+}
+
+// static
+QString MarkdownRenderer::toHtml(const QString &markdown) {
+    QString md = markdown;
+    md.replace(QLatin1String("\r\n"), QLatin1String("\n"));
+    return blocksHtml(md.split(QLatin1Char('\n')));
+}
+
+//////////////////////////////////////////////////////
+/// MarkdownRenderer
+
+MarkdownRenderer::MarkdownRenderer(QObject *parent)
+    : QObject{parent}
+{
+}
+
+// Removes renderings least recently used until the cache is well below
+// its limit
+static void trimCache(const QString &dirname) {
+    const QFileInfoList files = QDir(dirname).entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+    qint64 total = 0;
+    for (const QFileInfo &f: files) total += f.size();
+    if (total <= s_cache_max_bytes) return;
+
+    const qint64 target = qint64(s_cache_max_bytes * s_cache_trim_ratio);
+    for (const QFileInfo &f: files) {
+        if (total <= target) break;
+        if (QFile::remove(f.absoluteFilePath())) total -= f.size();
+    }
+}
+
+// static
+QString MarkdownRenderer::cacheFileName(const QString &url) {
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+            QStringLiteral("/sailfishos-chum-gui/markdown/") +
+            QString::fromLatin1(QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1).toHex()) +
+            QStringLiteral(".html");
+}
+
+QString MarkdownRenderer::text() const {
+    if (m_html.isEmpty()) return QString{};
+    return m_style + m_html;
+}
+
+void MarkdownRenderer::setLoading(bool loading) {
+    if (m_loading == loading) return;
+    m_loading = loading;
+    emit loadingChanged();
+}
+
+void MarkdownRenderer::setStyle(const QString &style) {
+    if (m_style == style) return;
+    m_style = style;
+    emit styleChanged();
+    if (!m_html.isEmpty()) emit textChanged();
+}
+
+void MarkdownRenderer::setUrl(const QString &url) {
+    if (m_url == url) return;
+    m_url = url;
+    m_html.clear();
+    m_hash.clear();
+    emit urlChanged();
+
+    if (!m_url.isEmpty()) {
+        // show cached rendering right away, the first line is the hash of its source
+        QFile file(cacheFileName(m_url));
+        if (file.open(QIODevice::ReadOnly)) {
+            m_hash = QString::fromLatin1(file.readLine().trimmed());
+            m_html = QString::fromUtf8(file.readAll());
+            // mark as recently used for trimming of the cache
+            ::utime(QFile::encodeName(file.fileName()).constData(), nullptr);
+        }
+    }
+
+    emit textChanged();
+    setLoading(!m_url.isEmpty() && m_html.isEmpty());
+    if (!m_url.isEmpty()) fetch();
+}
+
+void MarkdownRenderer::fetch() {
+    if (!nMng) {
+        setLoading(false);
+        return;
+    }
+    const QString url = m_url;
+    QNetworkRequest request{QUrl(url)};
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    QNetworkReply *reply = nMng->get(request);
+    connect(reply, &QNetworkReply::finished, this, [this, url, reply]() {
+        reply->deleteLater();
+        if (url != m_url) return; // superseded
+
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "Failed to fetch Markdown document" << url << reply->errorString();
+            setLoading(false);
+            return;
+        }
+
+        const QByteArray data = reply->readAll();
+        const QString hash = QString::fromLatin1(
+                    QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+        if (hash == m_hash) {
+            setLoading(false);
+            return; // cached rendering is up to date
+        }
+
+        MarkdownTask *task = new MarkdownTask(url, data);
+        connect(task, &MarkdownTask::rendered, this, &MarkdownRenderer::onRendered);
+        connect(task, &MarkdownTask::rendered, task, &QObject::deleteLater);
+        QThreadPool::globalInstance()->start(task);
+    });
+}
+
+void MarkdownRenderer::onRendered(const QString &url, const QString &hash, const QString &html) {
+    if (url != m_url) return; // superseded
+    m_hash = hash;
+    m_html = html;
+    setLoading(false);
+    emit textChanged();
+}
+
+//////////////////////////////////////////////////////
+/// MarkdownTask
+
+MarkdownTask::MarkdownTask(const QString &url, const QByteArray &markdown)
+    : m_url(url),
+      m_markdown(markdown)
+{
+    // deleted after delivering the result to the GUI thread
+    setAutoDelete(false);
+}
+
+void MarkdownTask::run() {
+    const QString hash = QString::fromLatin1(
+                QCryptographicHash::hash(m_markdown, QCryptographicHash::Sha1).toHex());
+    const QString html = m_markdown.trimmed().isEmpty() ? QString{} :
+                                                          MarkdownRenderer::toHtml(QString::fromUtf8(m_markdown));
+
+    const QString filename = MarkdownRenderer::cacheFileName(m_url);
+    const QString dirname = QFileInfo(filename).absolutePath();
+    QDir().mkpath(dirname);
+    QSaveFile file(filename);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(hash.toLatin1() + '\n');
+        file.write(html.toUtf8());
+        if (file.commit()) trimCache(dirname);
+    }
+
+    emit rendered(m_url, hash, html);
+}
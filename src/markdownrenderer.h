@@ -0,0 +1,74 @@
+#ifndef MARKDOWNRENDERER_H
+#define MARKDOWNRENDERER_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QString>
+
+/// Fetches Markdown documents, such as package descriptions, and renders
+/// them into Qt rich text on a worker thread. Rendered documents are
+/// cached on disk keyed by URL together with the hash of the Markdown
+/// source, so that a cached rendering is shown immediately and only
+/// replaced if the fetched document changed. The cache is limited in
+/// size, removing renderings least recently shown.
+class MarkdownRenderer : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString url READ url WRITE setUrl NOTIFY urlChanged)
+    Q_PROPERTY(QString style READ style WRITE setStyle NOTIFY styleChanged)
+    Q_PROPERTY(QString text READ text NOTIFY textChanged)
+    Q_PROPERTY(bool    loading READ loading NOTIFY loadingChanged)
+
+public:
+    explicit MarkdownRenderer(QObject *parent = nullptr);
+
+    QString url() const { return m_url; }
+    QString style() const { return m_style; }
+    QString text() const;
+    bool    loading() const { return m_loading; }
+
+    void setUrl(const QString &url);
+    void setStyle(const QString &style);
+
+    static QString toHtml(const QString &markdown);
+    static QString cacheFileName(const QString &url);
+
+signals:
+    void urlChanged();
+    void styleChanged();
+    void textChanged();
+    void loadingChanged();
+
+private slots:
+    void onRendered(const QString &url, const QString &hash, const QString &html);
+
+private:
+    void fetch();
+    void setLoading(bool loading);
+
+private:
+    QString m_url;
+    QString m_style;
+    QString m_html;
+    QString m_hash;
+    bool    m_loading{false};
+};
+
+class MarkdownTask : public QObject, public QRunnable
+{
+    Q_OBJECT
+public:
+    MarkdownTask(const QString &url, const QByteArray &markdown);
+
+    void run() override;
+
+signals:
+    void rendered(const QString &url, const QString &hash, const QString &html);
+
+private:
+    QString    m_url;
+    QByteArray m_markdown;
+};
+
+#endif // MARKDOWNRENDERER_H
@@ -0,0 +1,157 @@
+#include "networkmanager.h"
+#include "main.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QMutexLocker>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QSharedPointer>
+#include <QStandardPaths>
+#include <QThread>
+
+static const qint64 s_disk_cache_size{20*1024*1024};
+
+//////////////////////////////////////////////////////
+/// SharedDiskCache
+
+namespace {
+// QNetworkDiskCache can be used by one manager only and is not thread
+// safe. Managers of all threads get their own instance of this cache
+// which forwards to one disk cache, serializing the calls. Devices
+// returned by the disk cache are used by one manager at a time.
+class SharedDiskCache : public QAbstractNetworkCache
+{
+public:
+    explicit SharedDiskCache(QObject *parent) : QAbstractNetworkCache{parent} {}
+
+    QNetworkCacheMetaData metaData(const QUrl &url) override {
+        QMutexLocker lock(&s_mutex);
+        return cache()->metaData(url);
+    }
+    void updateMetaData(const QNetworkCacheMetaData &metaData) override {
+        QMutexLocker lock(&s_mutex);
+        cache()->updateMetaData(metaData);
+    }
+    QIODevice* data(const QUrl &url) override {
+        QMutexLocker lock(&s_mutex);
+        return cache()->data(url);
+    }
+    bool remove(const QUrl &url) override {
+        QMutexLocker lock(&s_mutex);
+        return cache()->remove(url);
+    }
+    qint64 cacheSize() const override {
+        QMutexLocker lock(&s_mutex);
+        return cache()->cacheSize();
+    }
+    QIODevice* prepare(const QNetworkCacheMetaData &metaData) override {
+        QMutexLocker lock(&s_mutex);
+        return cache()->prepare(metaData);
+    }
+    void insert(QIODevice *device) override {
+        QMutexLocker lock(&s_mutex);
+        cache()->insert(device);
+    }
+    void clear() override {
+        QMutexLocker lock(&s_mutex);
+        cache()->clear();
+    }
+
+private:
+    // called with the mutex locked, the cache is never deleted as managers
+    // of other threads may outlive the application object
+    static QNetworkDiskCache* cache() {
+        static QNetworkDiskCache *c = nullptr;
+        if (!c) {
+            c = new QNetworkDiskCache();
+            c->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+                                 QStringLiteral("/sailfishos-chum-gui/network"));
+            c->setMaximumCacheSize(s_disk_cache_size);
+        }
+        return c;
+    }
+
+    static QMutex s_mutex;
+};
+
+QMutex SharedDiskCache::s_mutex;
+}
+
+//////////////////////////////////////////////////////
+/// NetworkManager
+
+QMutex NetworkManager::s_mutex;
+QHash<QString, NetworkManager::HostStatistics> NetworkManager::s_statistics;
+
+NetworkManager::NetworkManager(bool disk_cache, QObject *parent)
+    : QNetworkAccessManager{parent}
+{
+    if (disk_cache)
+        setCache(new SharedDiskCache(this));
+}
+
+// Open encrypted connections in advance, so that the first request
+// to each of these hosts does not pay for TCP and TLS handshakes
+void NetworkManager::prewarm(const QStringList &hosts) {
+    for (const QString &host: hosts)
+        if (!host.isEmpty())
+            connectToHostEncrypted(host);
+}
+
+QNetworkReply* NetworkManager::createRequest(Operation op, const QNetworkRequest &request,
+                                             QIODevice *outgoingData) {
+    QNetworkRequest req(request);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+    req.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+#else
+    req.setAttribute(QNetworkRequest::SpdyAllowedAttribute, true);
+#endif
+
+    QNetworkReply *reply = QNetworkAccessManager::createRequest(op, req, outgoingData);
+
+    const QString host = req.url().host();
+    if (host.isEmpty()) return reply;
+    {
+        QMutexLocker lock(&s_mutex);
+        ++s_statistics[host].requests;
+    }
+
+    auto received = QSharedPointer<qint64>::create(0);
+    connect(reply, &QNetworkReply::downloadProgress, reply, [host, received](qint64 bytes, qint64) {
+        QMutexLocker lock(&s_mutex);
+        s_statistics[host].bytes += bytes - *received;
+        *received = bytes;
+    });
+    connect(reply, &QNetworkReply::finished, reply, [host, reply]() {
+        if (reply->error() == QNetworkReply::NoError) return;
+        QMutexLocker lock(&s_mutex);
+        ++s_statistics[host].errors;
+    });
+
+    return reply;
+}
+
+// static
+QVariantMap NetworkManager::statistics() {
+    QMutexLocker lock(&s_mutex);
+    QVariantMap result;
+    for (auto it = s_statistics.constBegin(); it != s_statistics.constEnd(); ++it)
+        result.insert(it.key(), QVariantMap{
+                          {QStringLiteral("requests"), it.value().requests},
+                          {QStringLiteral("bytes"), it.value().bytes},
+                          {QStringLiteral("errors"), it.value().errors}
+                      });
+    return result;
+}
+
+//////////////////////////////////////////////////////
+/// NetworkManagerFactory
+
+QNetworkAccessManager* NetworkManagerFactory::create(QObject *parent) {
+    // the shared manager lives in the main thread and is not owned by the engine
+    if (nMng && QThread::currentThread() == nMng->thread())
+        return nMng;
+    // managers of other threads share the disk cache and request settings
+    return new NetworkManager(true, parent);
+}
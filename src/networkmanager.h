@@ -0,0 +1,50 @@
+#ifndef NETWORKMANAGER_H
+#define NETWORKMANAGER_H
+
+#include <QHash>
+#include <QMutex>
+#include <QNetworkAccessManager>
+#include <QQmlNetworkAccessManagerFactory>
+#include <QStringList>
+#include <QVariantMap>
+
+/// Network access manager used for all requests of the application,
+/// from C++ as well as from QML. It allows HTTP/2 (SPDY on older Qt),
+/// uses a persistent disk cache and counts requests and received bytes
+/// per host for diagnostics. Managers created for other threads share
+/// the same disk cache.
+class NetworkManager : public QNetworkAccessManager
+{
+    Q_OBJECT
+public:
+    explicit NetworkManager(bool disk_cache, QObject *parent = nullptr);
+
+    void prewarm(const QStringList &hosts);
+
+    static QVariantMap statistics();
+
+protected:
+    QNetworkReply* createRequest(Operation op, const QNetworkRequest &request,
+                                 QIODevice *outgoingData = nullptr) override;
+
+private:
+    struct HostStatistics {
+        qint64 requests{0};
+        qint64 bytes{0};
+        qint64 errors{0};
+    };
+
+    static QMutex s_mutex;
+    static QHash<QString, HostStatistics> s_statistics;
+};
+
+/// Hands out the shared network access manager to the QML engine for
+/// its own thread and a manager with the same disk cache and request
+/// settings for other threads.
+class NetworkManagerFactory : public QQmlNetworkAccessManagerFactory
+{
+public:
+    QNetworkAccessManager* create(QObject *parent) override;
+};
+
+#endif // NETWORKMANAGER_H
@@ -0,0 +1,177 @@
+#include "operationprogress.h"
+#include "packageid.h"
+#include "tracer.h"
+
+using namespace PackageKit;
+
+// minimal interval between published updates, about one frame
+static const int s_update_interval_ms{16};
+
+OperationProgress::OperationProgress(QObject *parent)
+    : QObject{parent}
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(s_update_interval_ms);
+    connect(&m_timer, &QTimer::timeout, this, &OperationProgress::update);
+}
+
+void OperationProgress::start(Transaction *transaction) {
+    if (m_transaction)
+        m_transaction->disconnect(this);
+    m_transaction = transaction;
+
+    m_percentage = -1;
+    m_status = Transaction::StatusUnknown;
+    m_package_name.clear();
+    m_package_percentage = -1;
+    m_speed = 0;
+    m_remaining_time = 0;
+    m_download_remaining = 0;
+    m_item_id.clear();
+    m_item_percentage = -1;
+
+    m_trace_start = Tracer::instance()->now();
+    m_download_total = 0;
+    m_speed_sum = 0;
+    m_speed_samples = 0;
+    m_speed_peak = 0;
+    m_packages = 0;
+
+    connect(transaction, &Transaction::percentageChanged, this, &OperationProgress::scheduleUpdate);
+    connect(transaction, &Transaction::statusChanged, this, &OperationProgress::scheduleUpdate);
+    connect(transaction, &Transaction::speedChanged, this, &OperationProgress::scheduleUpdate);
+    connect(transaction, &Transaction::remainingTimeChanged, this, &OperationProgress::scheduleUpdate);
+    connect(transaction, &Transaction::downloadSizeRemainingChanged, this, &OperationProgress::scheduleUpdate);
+    connect(transaction, &Transaction::itemProgress, this, [this](
+            const QString &itemID,
+            [[maybe_unused]] Transaction::Status status,
+            uint percentage) {
+        this->setItemProgress(itemID, percentage);
+    });
+
+    if (!m_active) {
+        m_active = true;
+        emit activeChanged();
+    }
+    emit changed();
+}
+
+void OperationProgress::finish(bool success) {
+    update();
+    m_timer.stop();
+
+    Tracer *tracer = Tracer::instance();
+    if (tracer->enabled()) {
+        const qulonglong downloaded = m_download_total > m_download_remaining ?
+                    m_download_total - m_download_remaining : 0;
+        tracer->complete(QStringLiteral("operation"), QStringLiteral("operation"), m_trace_start, {
+                             {QStringLiteral("role"), m_transaction ? int(m_transaction->role()) : -1},
+                             {QStringLiteral("success"), success},
+                             {QStringLiteral("packages"), m_packages},
+                             {QStringLiteral("downloaded_bytes"), downloaded},
+                             {QStringLiteral("speed_avg"), m_speed_samples > 0 ? m_speed_sum / m_speed_samples : 0},
+                             {QStringLiteral("speed_peak"), m_speed_peak}
+                         });
+    }
+
+    if (m_transaction)
+        m_transaction->disconnect(this);
+    m_transaction.clear();
+
+    if (m_active) {
+        m_active = false;
+        emit activeChanged();
+    }
+}
+
+void OperationProgress::scheduleUpdate() {
+    if (!m_timer.isActive())
+        m_timer.start();
+}
+
+void OperationProgress::setItemProgress(const QString &item_id, uint percentage) {
+    if (item_id != m_item_id) {
+        m_item_id = item_id;
+        ++m_packages;
+    }
+    m_item_percentage = percentage <= 100 ? int(percentage) : -1;
+    scheduleUpdate();
+}
+
+void OperationProgress::update() {
+    if (!m_transaction) return;
+
+    // PackageKit reports 101 if the percentage is not known
+    const uint percentage = m_transaction->percentage();
+    m_percentage = percentage <= 100 ? int(percentage) : -1;
+    m_status = m_transaction->status();
+    m_speed = m_transaction->speed();
+    m_remaining_time = m_transaction->remainingTime();
+    m_download_remaining = m_transaction->downloadSizeRemaining();
+    if (!m_item_id.isEmpty())
+        m_package_name = PackageId(m_item_id).name();
+    m_package_percentage = m_item_percentage;
+
+    m_download_total = qMax(m_download_total, m_download_remaining);
+    if (m_speed > 0) {
+        m_speed_sum += m_speed;
+        ++m_speed_samples;
+        m_speed_peak = qMax(m_speed_peak, m_speed);
+    }
+
+    emit changed();
+}
+
+QString OperationProgress::statusText() const {
+    switch (m_status) {
+    case Transaction::StatusWait:
+    case Transaction::StatusWaitingForLock:
+    case Transaction::StatusWaitingForAuth:
+        //% "Waiting"
+        return qtTrId("chum-progress-waiting");
+    case Transaction::StatusSetup:
+    case Transaction::StatusLoadingCache:
+    case Transaction::StatusRefreshCache:
+    case Transaction::StatusDownloadRepository:
+    case Transaction::StatusDownloadPackagelist:
+    case Transaction::StatusDownloadFilelist:
+    case Transaction::StatusDownloadChangelog:
+    case Transaction::StatusDownloadGroup:
+    case Transaction::StatusDownloadUpdateinfo:
+        //% "Loading repository data"
+        return qtTrId("chum-progress-loading-data");
+    case Transaction::StatusDepResolve:
+    case Transaction::StatusQuery:
+    case Transaction::StatusInfo:
+        //% "Resolving dependencies"
+        return qtTrId("chum-progress-resolving");
+    case Transaction::StatusDownload:
+        //% "Downloading"
+        return qtTrId("chum-progress-downloading");
+    case Transaction::StatusSigCheck:
+    case Transaction::StatusTestCommit:
+        //% "Checking packages"
+        return qtTrId("chum-progress-checking");
+    case Transaction::StatusInstall:
+        //% "Installing"
+        return qtTrId("chum-progress-installing");
+    case Transaction::StatusUpdate:
+        //% "Updating"
+        return qtTrId("chum-progress-updating");
+    case Transaction::StatusRemove:
+    case Transaction::StatusCleanup:
+        //% "Removing"
+        return qtTrId("chum-progress-removing");
+    case Transaction::StatusCommit:
+    case Transaction::StatusRunning:
+    case Transaction::StatusScanApplications:
+    case Transaction::StatusGeneratePackageList:
+        //% "Processing"
+        return qtTrId("chum-progress-processing");
+    case Transaction::StatusFinished:
+        //% "Finishing"
+        return qtTrId("chum-progress-finishing");
+    default:
+        return QString{};
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef OPERATIONPROGRESS_H
+#define OPERATIONPROGRESS_H
+
+#include <PackageKit/Transaction>
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+/// Progress of the running package operation, as reported by the
+/// PackageKit transaction. Changes of the transaction are collected and
+/// published at most once per frame.
+class OperationProgress : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool    active READ active NOTIFY activeChanged)
+    Q_PROPERTY(int     percentage READ percentage NOTIFY changed)
+    Q_PROPERTY(QString statusText READ statusText NOTIFY changed)
+    Q_PROPERTY(QString packageName READ packageName NOTIFY changed)
+    Q_PROPERTY(int     packagePercentage READ packagePercentage NOTIFY changed)
+    Q_PROPERTY(uint    speed READ speed NOTIFY changed)
+    Q_PROPERTY(uint    remainingTime READ remainingTime NOTIFY changed)
+    Q_PROPERTY(qulonglong downloadSizeRemaining READ downloadSizeRemaining NOTIFY changed)
+
+public:
+    explicit OperationProgress(QObject *parent = nullptr);
+
+    bool    active() const { return m_active; }
+    int     percentage() const { return m_percentage; } // -1 if unknown
+    QString statusText() const;
+    QString packageName() const { return m_package_name; }
+    int     packagePercentage() const { return m_package_percentage; } // -1 if unknown
+    uint    speed() const { return m_speed; } // bytes per second
+    uint    remainingTime() const { return m_remaining_time; } // seconds
+    qulonglong downloadSizeRemaining() const { return m_download_remaining; }
+
+    void start(PackageKit::Transaction *transaction);
+    void finish(bool success);
+
+signals:
+    void activeChanged();
+    void changed();
+
+private:
+    void scheduleUpdate();
+    void update();
+    void setItemProgress(const QString &item_id, uint percentage);
+
+private:
+    QPointer<PackageKit::Transaction> m_transaction;
+    QTimer m_timer;
+
+    bool       m_active{false};
+    int        m_percentage{-1};
+    PackageKit::Transaction::Status m_status{PackageKit::Transaction::StatusUnknown};
+    QString    m_package_name;
+    int        m_package_percentage{-1};
+    uint       m_speed{0};
+    uint       m_remaining_time{0};
+    qulonglong m_download_remaining{0};
+
+    // pending item progress, applied with the next update
+    QString    m_item_id;
+    int        m_item_percentage{-1};
+
+    // throughput of the operation, recorded by the tracer
+    qint64     m_trace_start{0};
+    qulonglong m_download_total{0};
+    quint64    m_speed_sum{0};
+    uint       m_speed_samples{0};
+    uint       m_speed_peak{0};
+    int        m_packages{0};
+};
+
+#endif // OPERATIONPROGRESS_H
@@ -0,0 +1,40 @@
+#include "packageid.h"
+
+#include <QHash>
+
+PackageId::PackageId(const QString &pkid)
+{
+    if (pkid.isEmpty()) return;
+
+    // split into at most four fields, missing fields stay empty
+    QString fields[4];
+    int start = 0;
+    for (int i = 0; i < 3; ++i) {
+        const int end = pkid.indexOf(QLatin1Char(';'), start);
+        if (end < 0) {
+            fields[i] = pkid.mid(start);
+            start = -1;
+            break;
+        }
+        fields[i] = pkid.mid(start, end - start);
+        start = end + 1;
+    }
+    if (start >= 0)
+        fields[3] = pkid.mid(start);
+
+    d = QSharedPointer<Data>::create(
+                Data{pkid, fields[0], fields[1], fields[2], fields[3], qHash(pkid)});
+}
+
+qint64 PackageId::bytes() const {
+    if (!d) return sizeof(PackageId);
+    return sizeof(PackageId) + sizeof(Data) +
+            (d->id.size() + d->name.size() + d->version.size() +
+             d->arch.size() + d->data.size())*2;
+}
+
+bool PackageId::operator==(const PackageId &other) const {
+    if (d == other.d) return true;
+    if (!d || !other.d) return false;
+    return d->hash == other.d->hash && d->id == other.d->id;
+}
@@ -0,0 +1,49 @@
+#ifndef PACKAGEID_H
+#define PACKAGEID_H
+
+#include <QSharedPointer>
+#include <QString>
+
+/// PackageKit package ID of the form "name;version;arch;data", parsed
+/// once on construction. Copies share the parsed fields, the hash is
+/// computed together with them. Used through the refresh pipeline
+/// instead of splitting the ID string again at every stage.
+class PackageId
+{
+public:
+    PackageId() = default;
+    explicit PackageId(const QString &pkid);
+
+    bool isEmpty() const { return !d; }
+
+    QString toString() const { return d ? d->id : QString{}; }
+    QString name() const { return d ? d->name : QString{}; }
+    QString version() const { return d ? d->version : QString{}; }
+    QString arch() const { return d ? d->arch : QString{}; }
+    QString data() const { return d ? d->data : QString{}; }
+    uint    hash() const { return d ? d->hash : 0; }
+
+    // rough estimate of memory used by the parsed ID
+    qint64  bytes() const;
+
+    bool operator==(const PackageId &other) const;
+    bool operator!=(const PackageId &other) const { return !(*this == other); }
+
+private:
+    struct Data {
+        QString id;
+        QString name;
+        QString version;
+        QString arch;
+        QString data;
+        uint    hash;
+    };
+
+    QSharedPointer<Data> d; // not modified after construction
+};
+
+inline uint qHash(const PackageId &pkid, uint seed = 0) { return pkid.hash() ^ seed; }
+
+Q_DECLARE_TYPEINFO(PackageId, Q_MOVABLE_TYPE);
+
+#endif // PACKAGEID_H
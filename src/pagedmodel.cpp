@@ -0,0 +1,88 @@
+#include "pagedmodel.h"
+
+#include <QDebug>
+
+PagedModel::PagedModel(QObject *parent)
+    : QAbstractListModel{parent}
+{
+}
+
+bool PagedModel::canFetchMore(const QModelIndex &parent) const {
+    return !parent.isValid() && m_has_more && !m_loading && m_fetcher;
+}
+
+void PagedModel::fetchMore(const QModelIndex &parent) {
+    if (!canFetchMore(parent)) return;
+    m_request_id = QString::number(++m_request_serial) + QLatin1Char(':') + m_cursor;
+    setLoading(true);
+    m_fetcher();
+}
+
+void PagedModel::loadMore() {
+    fetchMore(QModelIndex{});
+}
+
+void PagedModel::reload() {
+    beginResetModel();
+    clearRows();
+    m_cursor.clear();
+    m_request_id.clear();
+    m_has_more = true;
+    m_loading = false;
+    endResetModel();
+    if (m_ready) {
+        m_ready = false;
+        emit readyChanged();
+    }
+    emit countChanged();
+    emit hasMoreChanged();
+    loadMore();
+}
+
+void PagedModel::setEmpty() {
+    beginResetModel();
+    clearRows();
+    m_request_id.clear();
+    m_has_more = false;
+    endResetModel();
+    setLoading(false);
+    m_ready = true;
+    emit readyChanged();
+    emit countChanged();
+    emit hasMoreChanged();
+}
+
+void PagedModel::finishPage(int added, const QString &next_cursor) {
+    if (added > 0)
+        emit countChanged();
+
+    m_cursor = next_cursor;
+    const bool more = !next_cursor.isEmpty() && added > 0;
+    if (m_has_more != more) {
+        m_has_more = more;
+        emit hasMoreChanged();
+    }
+    setLoading(false);
+    if (!m_ready) {
+        m_ready = true;
+        emit readyChanged();
+    }
+}
+
+void PagedModel::setFailed(const QString &request_id) {
+    if (request_id != m_request_id) return;
+    // stop requesting pages, the model can be reloaded later
+    m_has_more = false;
+    emit hasMoreChanged();
+    setLoading(false);
+    if (!m_ready) {
+        m_ready = true;
+        emit readyChanged();
+    }
+}
+
+void PagedModel::setLoading(bool loading) {
+    if (m_loading == loading) return;
+    m_loading = loading;
+    emit loadingChanged();
+}
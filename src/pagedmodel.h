@@ -0,0 +1,100 @@
+#ifndef PAGEDMODEL_H
+#define PAGEDMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+
+#include <functional>
+
+/// List model which is filled page by page on demand, as the view
+/// scrolls towards its end. Pages are requested through a fetcher,
+/// which reads the cursor of the next page and the request ID from the
+/// model. Rows are stored by subclasses, results for superseded requests
+/// are ignored.
+class PagedModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool ready READ ready NOTIFY readyChanged)
+    Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
+    Q_PROPERTY(bool hasMore READ hasMore NOTIFY hasMoreChanged)
+    Q_PROPERTY(int  count READ count NOTIFY countChanged)
+
+public:
+    using Fetcher = std::function<void()>;
+
+    explicit PagedModel(QObject *parent = nullptr);
+
+    bool ready() const { return m_ready; }
+    bool loading() const { return m_loading; }
+    bool hasMore() const { return m_has_more; }
+    int  count() const { return rowCount(); }
+    bool started() const { return m_request_serial > 0; }
+
+    QString cursor() const { return m_cursor; }
+    QString requestId() const { return m_request_id; }
+
+    void setFetcher(Fetcher fetcher) { m_fetcher = fetcher; }
+    void setEmpty();
+    void setFailed(const QString &request_id);
+
+    Q_INVOKABLE void reload();
+    Q_INVOKABLE void loadMore();
+
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+signals:
+    void readyChanged();
+    void loadingChanged();
+    void hasMoreChanged();
+    void countChanged();
+
+protected:
+    // called within model reset
+    virtual void clearRows() = 0;
+    // called after rows of the page were inserted
+    void finishPage(int added, const QString &next_cursor);
+
+private:
+    void setLoading(bool loading);
+
+private:
+    Fetcher m_fetcher;
+    QString m_cursor;
+    QString m_request_id;
+    int     m_request_serial{0};
+    bool    m_ready{false};
+    bool    m_loading{false};
+    bool    m_has_more{true};
+};
+
+/// Paged model storing rows of type T
+template <typename T>
+class PagedListModel : public PagedModel
+{
+public:
+    explicit PagedListModel(QObject *parent = nullptr) : PagedModel(parent) {}
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override {
+        return !parent.isValid() ? m_items.size() : 0;
+    }
+
+    void appendPage(const QString &request_id, const QVector<T> &rows, const QString &next_cursor) {
+        if (request_id != requestId()) return; // superseded request
+        if (!rows.isEmpty()) {
+            beginInsertRows(QModelIndex{}, m_items.size(), m_items.size() + rows.size() - 1);
+            m_items += rows;
+            endInsertRows();
+        }
+        finishPage(rows.size(), next_cursor);
+    }
+
+protected:
+    void clearRows() override { m_items.clear(); }
+
+protected:
+    QVector<T> m_items;
+};
+
+#endif // PAGEDMODEL_H
@@ -0,0 +1,55 @@
+#include "performanceprofile.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QSettings>
+#include <QThread>
+
+static const QString s_config_profile{QStringLiteral("main/performanceProfile")};
+// devices below these limits use the low-end profile
+static const qint64 s_low_end_ram_kb{2560*1024};
+static const int s_low_end_cores{4};
+
+PerformanceProfile *PerformanceProfile::s_instance{nullptr};
+
+PerformanceProfile::PerformanceProfile()
+{
+    QSettings settings;
+    const int mode = settings.value(s_config_profile, int(Auto)).toInt();
+    setMode(mode >= Auto && mode <= LowEnd ? Mode(mode) : Auto);
+}
+
+PerformanceProfile* PerformanceProfile::instance() {
+    if (!s_instance) s_instance = new PerformanceProfile();
+    return s_instance;
+}
+
+void PerformanceProfile::setMode(Mode mode) {
+    if (m_mode != mode) {
+        QSettings settings;
+        settings.setValue(s_config_profile, int(mode));
+    }
+    m_mode = mode;
+    m_low_end = mode == LowEnd || (mode == Auto && detectLowEnd());
+}
+
+// static
+bool PerformanceProfile::detectLowEnd() {
+    static int detected = -1;
+    if (detected >= 0) return detected > 0;
+
+    qint64 ram_kb = 0;
+    QFile meminfo(QStringLiteral("/proc/meminfo"));
+    if (meminfo.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        const QByteArray line = meminfo.readLine();
+        // MemTotal:        1870836 kB
+        if (line.startsWith("MemTotal:"))
+            ram_kb = line.mid(9).trimmed().split(' ').value(0).toLongLong();
+    }
+    const int cores = QThread::idealThreadCount();
+
+    detected = (ram_kb > 0 && ram_kb < s_low_end_ram_kb) || (cores > 0 && cores < s_low_end_cores);
+    qDebug() << "Device has" << ram_kb / 1024 << "MB RAM and" << cores << "cores, using"
+             << (detected ? "low-end" : "standard") << "performance profile by default";
+    return detected > 0;
+}
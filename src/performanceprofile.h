@@ -0,0 +1,50 @@
+#ifndef PERFORMANCEPROFILE_H
+#define PERFORMANCEPROFILE_H
+
+#include <QtGlobal>
+
+/// Performance settings tuned for the device. The profile is selected
+/// automatically from the amount of RAM and the number of CPU cores or
+/// set by the user, and read by the subsystems it tunes: forge requests
+/// loading package details, image decoding, memory caches and search in
+/// package lists.
+class PerformanceProfile
+{
+public:
+    enum Mode {
+        Auto = 0,
+        Standard,
+        LowEnd
+    };
+
+    static PerformanceProfile* instance();
+
+    Mode mode() const { return m_mode; }
+    void setMode(Mode mode);
+
+    // effective profile
+    bool lowEnd() const { return m_low_end; }
+    // profile selected by Auto
+    static bool detectLowEnd();
+
+    // forge requests loading package details in the background at once
+    int  hydrationConcurrency() const { return m_low_end ? 2 : 6; }
+    // longer side of decoded images in pixels, 0 for no limit
+    int  maxImageSize() const { return m_low_end ? 1280 : 0; }
+    int  imageCacheKb() const { return m_low_end ? 6*1024 : 16*1024; }
+    // downloaded images and thumbnails kept on disk
+    qint64 imageDiskCacheBytes() const { return (m_low_end ? 32 : 96)*1024*1024; }
+    int  detailsCacheBytes() const { return m_low_end ? 512*1024 : 2*1024*1024; }
+    int  searchDebounceMs() const { return m_low_end ? 400 : 0; }
+
+private:
+    PerformanceProfile();
+
+private:
+    Mode m_mode{Auto};
+    bool m_low_end{false};
+
+    static PerformanceProfile *s_instance;
+};
+
+#endif // PERFORMANCEPROFILE_H
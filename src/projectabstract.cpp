@@ -1,7 +1,9 @@
 #include "projectabstract.h"
 #include "chumpackage.h"
+#include "main.h"
 
-#include <QLocale>
+// defined here to keep the core library self-contained, set up by the application
+QNetworkAccessManager *nMng{nullptr};
 
 ProjectAbstract::ProjectAbstract(ChumPackage *package) :
     QObject(package),
@@ -10,8 +12,20 @@ ProjectAbstract::ProjectAbstract(ChumPackage *package) :
 }
 
 QString ProjectAbstract::parseDate(QString txt, bool short_format) {
-    QDateTime dt = QDateTime::fromString(txt, Qt::ISODate);
-    return QLocale::system().toString(dt.toLocalTime().date(),
-                                      short_format ? QLocale::ShortFormat :
-                                                     QLocale::LongFormat);
+    return DateFormatter::format(DateFormatter::parse(txt), short_format);
+}
+
+//////////////////////////////////////////////////////
+/// ParseTask
+
+ParseTask::ParseTask(std::function<void()> job)
+    : m_job(job)
+{
+    // deleted after delivering the result to the GUI thread
+    setAutoDelete(false);
+}
+
+void ParseTask::run() {
+    m_job();
+    emit finished();
 }
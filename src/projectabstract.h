@@ -2,8 +2,15 @@
 #define PROJECTABSTRACT_H
 
 #include <QObject>
+#include <QRunnable>
+#include <QSharedPointer>
+#include <QThreadPool>
 
+#include "forgemodels.h"
 #include "loadableobject.h"
+#include "stallwatchdog.h"
+
+#include <functional>
 
 class ChumPackage;
 
@@ -14,16 +21,56 @@ public:
     explicit ProjectAbstract(ChumPackage *package);
 
     virtual void issue(const QString &id, LoadableObject *value) = 0;
-    virtual void issues(LoadableObject *value) = 0;
+    virtual void issues(IssuesModel *value) = 0;
     virtual void release(const QString &id, LoadableObject *value) = 0;
-    virtual void releases(LoadableObject *value) = 0;
+    virtual void releases(ReleasesModel *value) = 0;
 
     static QString parseDate(QString txt, bool short_format=false);
 
+    // number of list entries requested per page
+    static const int pageSize{30};
+
 signals:
 
+protected:
+    // Decode response data on the worker pool and deliver the result on
+    // the GUI thread. Parser should not access the project or the package.
+    template <typename Result>
+    void parseAsync(const QByteArray &data,
+                    std::function<Result(const QByteArray &data)> parser,
+                    std::function<void(const Result &result)> done);
+
 protected:
     ChumPackage *m_package;
 };
 
+class ParseTask : public QObject, public QRunnable
+{
+    Q_OBJECT
+public:
+    explicit ParseTask(std::function<void()> job);
+
+    void run() override;
+
+signals:
+    void finished();
+
+private:
+    std::function<void()> m_job;
+};
+
+template <typename Result>
+void ProjectAbstract::parseAsync(const QByteArray &data,
+                                 std::function<Result(const QByteArray &data)> parser,
+                                 std::function<void(const Result &result)> done) {
+    QSharedPointer<Result> result = QSharedPointer<Result>::create();
+    ParseTask *task = new ParseTask([data, parser, result](){ *result = parser(data); });
+    connect(task, &ParseTask::finished, this, [done, result](){
+        StallWatchdog::Section section("forge result");
+        done(*result);
+    });
+    connect(task, &ParseTask::finished, task, &QObject::deleteLater);
+    QThreadPool::globalInstance()->start(task);
+}
+
 #endif // PROJECTABSTRACT_H
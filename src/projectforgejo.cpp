@@ -1,6 +1,7 @@
 #include "projectforgejo.h"
 #include "chumpackage.h"
 #include "main.h"
+#include "tracer.h"
 
 #include <QDebug>
 #include <QJsonArray>
@@ -10,6 +11,7 @@
 #include <QLocale>
 #include <QNetworkRequest>
 #include <QNetworkReply>
+#include <QPointer>
 #include <QSharedPointer>
 #include <QUrl>
 #include <QVariantList>
@@ -20,10 +22,10 @@ QMap<QString, QString> ProjectForgejo::s_sites;
 //////////////////////////////////////////////////////
 /// helper functions
 
-static QString getName(const QVariant &v) {
-  QVariantMap m = v.toMap();
-  QString login = m[QLatin1String("username")].toString();
-  QString name = m[QLatin1String("full_name")].toString();
+static QString getName(const QJsonValue &v) {
+  QJsonObject m = v.toObject();
+  QString login = m.value(QLatin1String("username")).toString();
+  QString name = m.value(QLatin1String("full_name")).toString();
   if (login.isEmpty() || name==login) return name;
   if (name.isEmpty()) return login;
   return QStringLiteral("%1 (%2)").arg(name, login);
@@ -72,6 +74,12 @@ void ProjectForgejo::initSites() {
   }
 }
 
+// static
+QStringList ProjectForgejo::hosts() {
+  initSites();
+  return s_sites.keys();
+}
+
 // static
 bool ProjectForgejo::isProject(const QString &url) {
   initSites();
@@ -80,82 +88,93 @@ bool ProjectForgejo::isProject(const QString &url) {
   return s_sites.contains(h);
 }
 
-QNetworkReply* ProjectForgejo::sendQuery(const QString &query) {
+QNetworkReply* ProjectForgejo::sendQuery(const QString &query, const RequestPolicy &policy) {
   QString reqAuth = QStringLiteral("token %1").arg(m_token);
   QString reqUrl = QStringLiteral("https://%1/api/v1%2").arg(m_host).arg(query);
   QNetworkRequest request;
   request.setUrl(reqUrl);
   request.setRawHeader("Content-Type", "application/json");
   request.setRawHeader("Authorization", reqAuth.toLocal8Bit());
-  return nMng->get(request);
+  QNetworkReply *reply = ForgeReply::get(request, QStringLiteral("forgejo"), policy);
+  Tracer::instance()->traceReply(reply, QStringLiteral("forgejo"));
+  return reply;
 }
 
 void ProjectForgejo::fetchRepoInfo() {
-  QNetworkReply *reply = sendQuery(QStringLiteral("/repos/%1").arg(m_path));
+  QNetworkReply *reply = sendQuery(QStringLiteral("/repos/%1").arg(m_path), RequestPolicy::background());
   connect(reply, &QNetworkReply::finished, this, [this, reply](){
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "Forgejo: Failed to fetch repository data for Forgejo" << this->m_path;
       qWarning() << "Forgejo: Error: " << reply->errorString();
     }
 
-    QByteArray data = reply->readAll();
-    QJsonObject r = QJsonDocument::fromJson(data).object();
+    parseAsync<QJsonObject>(reply->readAll(), [](const QByteArray &data) {
+      return QJsonDocument::fromJson(data).object();
+    }, [this](const QJsonObject &r) {
+      QString v;
+      int vi;
 
-    QString v;
-    int vi;
+      v = r.value("owner").toObject().value("login").toString();
+      if (!v.isEmpty()) m_package->setDeveloperLogin(v);
 
-    v = r.value("owner").toObject().value("login").toString();
-    if (!v.isEmpty()) m_package->setDeveloperLogin(v);
+      v = r.value("owner").toObject().value("full_name").toString();
+      if (!v.isEmpty()) m_package->setDeveloperName(v);
 
-    v = r.value("owner").toObject().value("full_name").toString();
-    if (!v.isEmpty()) m_package->setDeveloperName(v);
+      v = r.value("website").toString();
+      if (!v.isEmpty()) m_package->setUrl(v);
 
-    v = r.value("website").toString();
-    if (!v.isEmpty()) m_package->setUrl(v);
+      vi = r.value("stars_count").toInt(-1);
+      if (vi>=0) m_package->setStarsCount(vi);
 
-    vi = r.value("stars_count").toInt(-1);
-    if (vi>=0) m_package->setStarsCount(vi);
+      vi = r.value("forks_count").toInt(-1);
+      if (vi>=0) m_package->setForksCount(vi);
 
-    vi = r.value("forks_count").toInt(-1);
-    if (vi>=0) m_package->setForksCount(vi);
-
-    vi = r.value("open_issues_count").toInt(-1);
-    if (vi>=0) m_package->setIssuesCount(vi);
-
-    vi = r.value("release_counter").toInt(-1);
-    if (vi>=0) m_package->setReleasesCount(vi);
+      vi = r.value("open_issues_count").toInt(-1);
+      if (vi>=0) m_package->setIssuesCount(vi);
 
+      vi = r.value("release_counter").toInt(-1);
+      if (vi>=0) m_package->setReleasesCount(vi);
+    });
     reply->deleteLater();
   });
 }
 
-void ProjectForgejo::comments(const QString &issue_id, const QVariantMap &comment, LoadableObject *value) {
+void ProjectForgejo::comments(const QString &issue_id, const QVariantMap &issue, LoadableObject *value) {
   QNetworkReply *reply = sendQuery( QStringLiteral("/repos/%1/issues/%2/comments").arg(m_path).arg(issue_id));
-  connect(reply, &QNetworkReply::finished, this, [this, issue_id, comment, reply, value](){
+  connect(reply, &QNetworkReply::finished, this, [this, issue_id, issue, reply, value](){
+    if (value->valueId() != issue_id) {
+      reply->deleteLater();
+      return; // superseded by another request
+    }
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "Forgejo: Failed to fetch issue for" << this->m_path;
       qWarning() << "Forgejo: Error: " << reply->errorString();
+      value->setValue(issue_id, QVariantMap{});
+      reply->deleteLater();
+      return;
     }
 
-    QByteArray data = reply->readAll();
-    QVariantList r = QJsonDocument::fromJson(data).array().toVariantList();
-
-    QVariantList rlist;
-    rlist.append(comment); // add issue comment as first comment
-    for (const auto &e: r) {
-      QVariantMap element = e.toMap();
-      QVariantMap m;
-      m["author"] = getName(element.value("user"));
-      m["created"] = parseDate(element.value("created_at").toString(), true);
-      m["updated"] = parseDate(element.value("updated_at").toString(), true);
-      m["body"] = element.value("body").toString();
-      rlist.append(m);
-    }
-
-    QVariantMap result = value->value();
-    result["discussion"] = rlist;
+    QPointer<LoadableObject> target(value);
+    parseAsync<QVariantMap>(reply->readAll(), [issue](const QByteArray &data) {
+      const QJsonArray r = QJsonDocument::fromJson(data).array();
+
+      // issue comment is already added as the first comment
+      QVariantMap result = issue;
+      Discussion discussion = result.value("discussion").value<Discussion>();
+      discussion.reserve(r.size() + 1);
+      for (const QJsonValue &e: r) {
+        QJsonObject element = e.toObject();
+        discussion.append(CommentItem{getName(element.value("user")),
+                                      element.value("body").toString(),
+                                      DateFormatter::parse(element.value("created_at").toString()),
+                                      DateFormatter::parse(element.value("updated_at").toString())});
+      }
+      result["discussion"] = QVariant::fromValue(discussion);
 
-    value->setValue(issue_id, result);
+      return result;
+    }, [issue_id, target](const QVariantMap &result) {
+      if (target) target->setValue(issue_id, result);
+    });
     reply->deleteLater();
   });
 }
@@ -167,72 +186,90 @@ void ProjectForgejo::issue(const QString &issue_id, LoadableObject *value) {
 
   QNetworkReply *reply = sendQuery( QStringLiteral("/repos/%1/issues/%2").arg(m_path).arg(issue_id));
   connect(reply, &QNetworkReply::finished, this, [this, issue_id, reply, value](){
+    if (value->valueId() != issue_id) {
+      reply->deleteLater();
+      return; // superseded by another request
+    }
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "Forgejo: Failed to fetch issue for" << this->m_path;
       qWarning() << "Forgejo: Error: " << reply->errorString();
+      value->setValue(issue_id, QVariantMap{});
+      reply->deleteLater();
+      return;
     }
 
-    QByteArray data = reply->readAll();
-    QVariantMap r = QJsonDocument::fromJson(data).object().toVariantMap();
-
-    QVariantMap result;
-    result["id"] = r.value("number").toInt();
-    result["number"] = r.value("number");
-    result["title"] = r.value("title");
-    result["commentsCount"] = r.value("comments").toInt();
-
-    value->setValue(issue_id, result);
-
-    // load comments separately: save "first comment"
-    QVariantMap commentZero;
-    commentZero["author"] = getName(r.value("user"));
-    commentZero["created"] = parseDate(r.value("created_at").toString(), true);
-    commentZero["updated"] = parseDate(r.value("updated_at").toString(), true);
-    // FIXME: this is stored as markdown, not HTML
-    //        maybe use /miscellaneous/renderMarkdown to get HTML
-    commentZero["body"] = r.value("body").toString();
-
-    // load comments
-    comments(result["id"].toString(), commentZero, value);
-
+    QPointer<LoadableObject> target(value);
+    parseAsync<QVariantMap>(reply->readAll(), [](const QByteArray &data) {
+      QJsonObject r = QJsonDocument::fromJson(data).object();
+
+      QVariantMap result;
+      result["id"] = r.value("number").toInt();
+      result["number"] = r.value("number").toInt();
+      result["title"] = r.value("title").toString();
+      result["commentsCount"] = r.value("comments").toInt();
+
+      // comments are loaded separately: save "first comment"
+      // FIXME: body is stored as markdown, not HTML
+      //        maybe use /miscellaneous/renderMarkdown to get HTML
+      Discussion discussion;
+      discussion.append(CommentItem{getName(r.value("user")),
+                                    r.value("body").toString(),
+                                    DateFormatter::parse(r.value("created_at").toString()),
+                                    DateFormatter::parse(r.value("updated_at").toString())});
+      result["discussion"] = QVariant::fromValue(discussion);
+
+      return result;
+    }, [this, issue_id, target](const QVariantMap &result) {
+      // load comments, value is set when they are received
+      if (target) comments(issue_id, result, target);
+    });
     reply->deleteLater();
   });
 }
 
-void ProjectForgejo::issues(LoadableObject *value) {
-  const QString issues_id{QStringLiteral("issues")};
-  value->reset(issues_id);
+void ProjectForgejo::issues(IssuesModel *value) {
+  // REST API is paginated by page number, starting from 1
+  const QString request_id = value->requestId();
+  const int page = value->cursor().isEmpty() ? 1 : value->cursor().toInt();
 
-  QNetworkReply *reply = sendQuery( QStringLiteral("/repos/%1/%2?state=open&type=issue").arg(m_path).arg(issues_id));
+  QNetworkReply *reply = sendQuery( QStringLiteral("/repos/%1/issues?state=open&type=issue&page=%2&limit=%3")
+                                    .arg(m_path).arg(page).arg(pageSize));
 
-  connect(reply, &QNetworkReply::finished, this, [this, issues_id, reply, value](){
+  QPointer<IssuesModel> model(value);
+  connect(reply, &QNetworkReply::finished, this, [this, request_id, page, reply, model](){
+    reply->deleteLater();
+    if (!model || model->requestId() != request_id) return; // superseded
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "Forgejo: Failed to fetch issues for" << this->m_path;
       qWarning() << "Forgejo: Error: " << reply->errorString();
+      model->setFailed(request_id);
+      return;
     }
 
-    QByteArray data = reply->readAll();
-    QVariantList r = QJsonDocument::fromJson(data).array().toVariantList();
-
-    QVariantList rlist;
-    for (const auto &e: r) {
-      QVariantMap element = e.toMap();
-      QVariantMap m;
-      m["id"] = element.value("number");
-      m["author"] = getName(element.value("user"));
-      m["commentsCount"] = element.value("comments");
-      m["number"] = element.value("number");
-      m["title"] = element.value("title");
-      m["created"] = parseDate(element.value("created_at").toString(), true);
-      m["updated"] = parseDate(element.value("updated_at").toString(), true);
-      rlist.append(m);
-    }
+    parseAsync<IssuesPage>(reply->readAll(), [page](const QByteArray &data) {
+      const QJsonArray r = QJsonDocument::fromJson(data).array();
+
+      QVector<IssueItem> rlist;
+      rlist.reserve(r.size());
+      for (const QJsonValue &e: r) {
+        QJsonObject element = e.toObject();
+        IssueItem m;
+        m.number = QString::number(element.value("number").toInt());
+        m.author = getName(element.value("user"));
+        m.comments_count = element.value("comments").toInt();
+        m.title = element.value("title").toString();
+        m.created = DateFormatter::parse(element.value("created_at").toString());
+        m.updated = DateFormatter::parse(element.value("updated_at").toString());
+        rlist.append(m);
+      }
 
-    QVariantMap result;
-    result["issues"] = rlist;
-    value->setValue(issues_id, result);
+      // a full page means there may be more to come
+      const QString next = r.size() >= pageSize ? QString::number(page + 1) : QString{};
 
-    reply->deleteLater();
+      return IssuesPage{rlist, next};
+    }, [request_id, model](const IssuesPage &result) {
+      if (model) model->appendPage(request_id, result.items, result.next_cursor);
+    });
   });
 }
 
@@ -245,54 +282,75 @@ void ProjectForgejo::release(const QString &release_id, LoadableObject *value) {
   QNetworkReply *reply = sendQuery( QStringLiteral("/repos/%1/releases/%2").arg(m_path).arg(release_id));
 
   connect(reply, &QNetworkReply::finished, this, [this, release_id, reply, value](){
+    if (value->valueId() != release_id) {
+      reply->deleteLater();
+      return; // superseded by another request
+    }
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "Forgejo: Failed to fetch release for" << this->m_path;
       qWarning() << "Forgejo: Error: " << reply->errorString();
+      value->setValue(release_id, QVariantMap{});
+      reply->deleteLater();
+      return;
     }
 
-    QByteArray data = reply->readAll();
-    QVariantMap r = QJsonDocument::fromJson(data).object().toVariantMap();
+    QPointer<LoadableObject> target(value);
+    parseAsync<QVariantMap>(reply->readAll(), [](const QByteArray &data) {
+      QVariantMap r = QJsonDocument::fromJson(data).object().toVariantMap();
 
-    QVariantMap result;
-    result["name"] = r.value("name");
-    result["description"] = r.value("body");
-    result["datetime"] = parseDate(r.value("created_at").toString());
+      QVariantMap result;
+      result["name"] = r.value("name");
+      result["description"] = r.value("body");
+      result["datetime"] = parseDate(r.value("created_at").toString());
 
-    value->setValue(release_id, result);
+      return result;
+    }, [release_id, target](const QVariantMap &result) {
+      if (target) target->setValue(release_id, result);
+    });
     reply->deleteLater();
   });
 }
 
 
-void ProjectForgejo::releases(LoadableObject *value) {
-  const QString releases_id{QStringLiteral("releases")};
-  value->reset(releases_id);
+void ProjectForgejo::releases(ReleasesModel *value) {
+  // REST API is paginated by page number, starting from 1
+  const QString request_id = value->requestId();
+  const int page = value->cursor().isEmpty() ? 1 : value->cursor().toInt();
 
-  QNetworkReply *reply = sendQuery( QStringLiteral("/repos/%1/%2?pre-release=true").arg(m_path).arg(releases_id));
+  QNetworkReply *reply = sendQuery( QStringLiteral("/repos/%1/releases?pre-release=true&page=%2&limit=%3")
+                                    .arg(m_path).arg(page).arg(pageSize));
 
-  connect(reply, &QNetworkReply::finished, this, [this, releases_id, reply, value](){
+  QPointer<ReleasesModel> model(value);
+  connect(reply, &QNetworkReply::finished, this, [this, request_id, page, reply, model](){
+    reply->deleteLater();
+    if (!model || model->requestId() != request_id) return; // superseded
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "Forgejo: Failed to fetch releases for" << this->m_path;
       qWarning() << "Forgejo: Error: " << reply->errorString();
+      model->setFailed(request_id);
+      return;
     }
 
-    QByteArray data = reply->readAll();
-    QVariantList r = QJsonDocument::fromJson(data).array().toVariantList();
-
-    QVariantList rlist;
-    for (const auto &e: r) {
-      QVariantMap element = e.toMap();
-      QVariantMap m;
-      m["id"] = element.value("id");
-      m["name"] = element.value("name");
-      m["datetime"] = parseDate(element.value("created_at").toString());
-      rlist.append(m);
-    }
+    parseAsync<ReleasesPage>(reply->readAll(), [page](const QByteArray &data) {
+      const QJsonArray r = QJsonDocument::fromJson(data).array();
+
+      QVector<ReleaseItem> rlist;
+      rlist.reserve(r.size());
+      for (const QJsonValue &e: r) {
+        QJsonObject element = e.toObject();
+        ReleaseItem m;
+        m.id = QString::number(element.value("id").toInt());
+        m.name = element.value("name").toString();
+        m.datetime = DateFormatter::parse(element.value("created_at").toString());
+        rlist.append(m);
+      }
 
-    QVariantMap result;
-    result["releases"] = rlist;
-    value->setValue(releases_id, result);
+      // a full page means there may be more to come
+      const QString next = r.size() >= pageSize ? QString::number(page + 1) : QString{};
 
-    reply->deleteLater();
+      return ReleasesPage{rlist, next};
+    }, [request_id, model](const ReleasesPage &result) {
+      if (model) model->appendPage(request_id, result.items, result.next_cursor);
+    });
   });
 }
@@ -6,6 +6,7 @@
 #include <QString>
 #include <QVariantMap>
 
+#include "forgereply.h"
 #include "projectabstract.h"
 
 class ProjectForgejo : public ProjectAbstract
@@ -15,21 +16,23 @@ public:
     explicit ProjectForgejo(const QString &url, ChumPackage *package);
 
     static bool isProject(const QString &url);
+    static QStringList hosts();
 
     virtual void issue(const QString &id, LoadableObject *value) override;
-    virtual void issues(LoadableObject *value) override;
+    virtual void issues(IssuesModel *value) override;
     virtual void release(const QString &id, LoadableObject *value) override;
-    virtual void releases(LoadableObject *value) override;
+    virtual void releases(ReleasesModel *value) override;
 
 signals:
 
 private:
-    QNetworkReply* sendQuery(const QString &query);
+    QNetworkReply* sendQuery(const QString &query,
+                             const RequestPolicy &policy = RequestPolicy::interactive());
     void fetchRepoInfo();
 
     static void initSites();
 
-    void comments(const QString &id, const QVariantMap &comment, LoadableObject *value);
+    void comments(const QString &id, const QVariantMap &issue, LoadableObject *value);
 private:
     QString m_host;
     QString m_path;
@@ -1,6 +1,8 @@
 #include "projectgithub.h"
 #include "chumpackage.h"
+#include "forgereply.h"
 #include "main.h"
+#include "tracer.h"
 
 #include <QDebug>
 #include <QJsonArray>
@@ -10,6 +12,7 @@
 #include <QLocale>
 #include <QNetworkRequest>
 #include <QNetworkReply>
+#include <QPointer>
 #include <QSharedPointer>
 #include <QUrl>
 #include <QVariantList>
@@ -21,21 +24,25 @@ static QString reqUrl{QStringLiteral("https://api.github.com/graphql")};
 //////////////////////////////////////////////////////
 /// helper functions
 
-static QString getName(const QVariant &v) {
-    QVariantMap m = v.toMap();
-    QString login = m[QLatin1String("login")].toString();
-    QString name = m[QLatin1String("name")].toString();
+static QString getName(const QJsonValue &v) {
+    QJsonObject m = v.toObject();
+    QString login = m.value(QLatin1String("login")).toString();
+    QString name = m.value(QLatin1String("name")).toString();
     if (login.isEmpty()) return name;
     if (name.isEmpty()) return login;
     return QStringLiteral("%1 (%2)").arg(name, login);
 }
 
-static QNetworkReply* sendQuery(const QString &query) {
+static QNetworkReply* sendQuery(const QString &query,
+                                const RequestPolicy &policy = RequestPolicy::interactive()) {
     QNetworkRequest request;
     request.setUrl(reqUrl);
     request.setRawHeader("Content-Type", "application/x-www-form-urlencoded");
     request.setRawHeader("Authorization", reqAuth.toLocal8Bit());
-    return nMng->post(request, query.toLocal8Bit());
+    // GraphQL queries do not modify data and can be repeated
+    QNetworkReply *reply = ForgeReply::post(request, query.toLocal8Bit(), QStringLiteral("github"), policy);
+    Tracer::instance()->traceReply(reply, QStringLiteral("github"));
+    return reply;
 }
 
 static bool parseUrl(const QString &u, QString &org, QString &repo) {
@@ -118,45 +125,46 @@ query {
 )").arg(m_org, m_repo);
     query = query.replace('\n', ' ');
 
-    QNetworkReply *reply = sendQuery(query);
+    QNetworkReply *reply = sendQuery(query, RequestPolicy::background());
     connect(reply, &QNetworkReply::finished, this, [this, reply](){
         if (reply->error() != QNetworkReply::NoError) {
             qWarning() << "Failed to fetch repository data for" << this->m_org << this->m_repo;
             qWarning() << "Error: " << reply->errorString();
         }
 
-        QJsonObject r{QJsonDocument::fromJson(reply->readAll()).object().
-                    value("data").toObject().value("repository").toObject()};
-
-        QString v;
-        int vi;
+        parseAsync<QJsonObject>(reply->readAll(), [](const QByteArray &data) {
+            return QJsonDocument::fromJson(data).object().
+                    value("data").toObject().value("repository").toObject();
+        }, [this](const QJsonObject &r) {
+            QString v;
+            int vi;
 
-        v = r.value("owner").toObject().value("login").toString();
-        if (!v.isEmpty()) m_package->setDeveloperLogin(v);
+            v = r.value("owner").toObject().value("login").toString();
+            if (!v.isEmpty()) m_package->setDeveloperLogin(v);
 
-        v = r.value("owner").toObject().value("name").toString();
-        if (!v.isEmpty()) m_package->setDeveloperName(v);
+            v = r.value("owner").toObject().value("name").toString();
+            if (!v.isEmpty()) m_package->setDeveloperName(v);
 
-        vi = r.value("stargazerCount").toInt(-1);
-        if (vi>=0) m_package->setStarsCount(vi);
+            vi = r.value("stargazerCount").toInt(-1);
+            if (vi>=0) m_package->setStarsCount(vi);
 
-        v = r.value("homepageUrl").toString();
-        if (!v.isEmpty()) m_package->setUrl(v);
-        else m_package->setUrl(QStringLiteral("https://github.com/%1/%2").arg(m_org, m_repo));
+            v = r.value("homepageUrl").toString();
+            if (!v.isEmpty()) m_package->setUrl(v);
+            else m_package->setUrl(QStringLiteral("https://github.com/%1/%2").arg(m_org, m_repo));
 
-        vi = r.value("forks").toObject().value("totalCount").toInt(-1);
-        if (vi>=0) m_package->setForksCount(vi);
+            vi = r.value("forks").toObject().value("totalCount").toInt(-1);
+            if (vi>=0) m_package->setForksCount(vi);
 
-        vi = r.value("issues").toObject().value("totalCount").toInt(-1);
-        if (vi>=0) m_package->setIssuesCount(vi);
+            vi = r.value("issues").toObject().value("totalCount").toInt(-1);
+            if (vi>=0) m_package->setIssuesCount(vi);
 
-        vi = r.value("releases").toObject().value("totalCount").toInt(-1);
-        if (vi>=0) m_package->setReleasesCount(vi);
-
-        vi = r.value("discussions").toObject().value("totalCount").toInt();
-        if (vi>=0)
-            m_package->setUrlForum(QStringLiteral("https://github.com/%1/%2/discussions").arg(m_org, m_repo));
+            vi = r.value("releases").toObject().value("totalCount").toInt(-1);
+            if (vi>=0) m_package->setReleasesCount(vi);
 
+            vi = r.value("discussions").toObject().value("totalCount").toInt();
+            if (vi>=0)
+                m_package->setUrlForum(QStringLiteral("https://github.com/%1/%2/discussions").arg(m_org, m_repo));
+        });
         reply->deleteLater();
     });
 }
@@ -216,56 +224,98 @@ query {
 
     QNetworkReply *reply = sendQuery(query);
     connect(reply, &QNetworkReply::finished, this, [this, issue_id, reply, value](){
+        if (value->valueId() != issue_id) {
+            reply->deleteLater();
+            return; // superseded by another request
+        }
         if (reply->error() != QNetworkReply::NoError) {
             qWarning() << "Failed to fetch issue for" << this->m_org << this->m_repo;
             qWarning() << "Error: " << reply->errorString();
+            value->setValue(issue_id, QVariantMap{});
+            reply->deleteLater();
+            return;
         }
 
-        QByteArray data = reply->readAll();
-        QVariantMap r = QJsonDocument::fromJson(data).object().
-                value("data").toObject().value("repository").toObject().
-                value("issue").toObject().toVariantMap();
-
-        QVariantMap result;
-        result["id"] = r.value("number");
-        result["commentsCount"] = r.value("comments").toMap().value("totalCount").toInt();
-        result["number"] = r.value("number");
-        result["title"] = r.value("title");
-        QVariantList clist = r.value("comments").toMap().value("nodes").toList();
-        QVariantList result_list;
-        QVariantMap m;
-        m["author"] = getName(r.value("author"));
-        m["created"] = parseDate(r.value("createdAt").toString(), true);
-        m["updated"] = parseDate(r.value("updatedAt").toString(), true);
-        m["body"] = r.value("bodyHTML").toString();
-        result_list.append(m);
-        for (const auto &e: clist) {
-            QVariantMap element = e.toMap();
-            m.clear();
-            m["author"] = getName(element.value("author"));
-            m["created"] = parseDate(element.value("createdAt").toString(), true);
-            m["updated"] = parseDate(element.value("updatedAt").toString(), true);
-            m["body"] = element.value("bodyHTML").toString();
-            result_list.append(m);
-        }
+        QPointer<LoadableObject> target(value);
+        parseAsync<QVariantMap>(reply->readAll(), [](const QByteArray &data) {
+            QJsonObject r = QJsonDocument::fromJson(data).object().
+                    value("data").toObject().value("repository").toObject().
+                    value("issue").toObject();
+
+            QVariantMap result;
+            result["id"] = r.value("number").toInt();
+            result["commentsCount"] = r.value("comments").toObject().value("totalCount").toInt();
+            result["number"] = r.value("number").toInt();
+            result["title"] = r.value("title").toString();
+            const QJsonArray clist = r.value("comments").toObject().value("nodes").toArray();
+            Discussion discussion;
+            discussion.reserve(clist.size() + 1);
+            discussion.append(CommentItem{getName(r.value("author")),
+                                          r.value("bodyHTML").toString(),
+                                          DateFormatter::parse(r.value("createdAt").toString()),
+                                          DateFormatter::parse(r.value("updatedAt").toString())});
+            for (const QJsonValue &e: clist) {
+                QJsonObject element = e.toObject();
+                discussion.append(CommentItem{getName(element.value("author")),
+                                              element.value("bodyHTML").toString(),
+                                              DateFormatter::parse(element.value("createdAt").toString()),
+                                              DateFormatter::parse(element.value("updatedAt").toString())});
+            }
+
+            result["discussion"] = QVariant::fromValue(discussion);
 
-        result["discussion"] = result_list;
-        value->setValue(issue_id, result);
+            return result;
+        }, [issue_id, target](const QVariantMap &result) {
+            if (target) target->setValue(issue_id, result);
+        });
         reply->deleteLater();
     });
 }
 
 
-void ProjectGitHub::issues(LoadableObject *value) {
-    const QString issues_id{QStringLiteral("issues")};
-    value->reset(issues_id);
+// Page of issues from the response of the issues query. Runs on the
+// worker pool.
+IssuesPage ProjectGitHub::parseIssues(const QByteArray &data) {
+    QJsonObject issues = QJsonDocument::fromJson(data).object().
+            value("data").toObject().value("repository").toObject().
+            value("issues").toObject();
+    const QJsonArray r = issues.value("nodes").toArray();
+    QJsonObject page = issues.value("pageInfo").toObject();
+
+    QVector<IssueItem> rlist;
+    rlist.reserve(r.size());
+    for (const QJsonValue &e: r) {
+        QJsonObject element = e.toObject();
+        IssueItem m;
+        m.number = QString::number(element.value("number").toInt());
+        m.author = getName(element.value("author"));
+        m.comments_count = element.value("comments").toObject().value("totalCount").toInt();
+        m.title = element.value("title").toString();
+        m.created = DateFormatter::parse(element.value("createdAt").toString());
+        m.updated = DateFormatter::parse(element.value("updatedAt").toString());
+        rlist.append(m);
+    }
+
+    const QString next = page.value("hasNextPage").toBool() ? page.value("endCursor").toString() : QString{};
+
+    return IssuesPage{rlist, next};
+}
+
+void ProjectGitHub::issues(IssuesModel *value) {
+    const QString request_id = value->requestId();
+    const QString after = value->cursor().isEmpty() ? QString{} :
+                                                      QStringLiteral(", after: \\\"%1\\\"").arg(value->cursor());
 
     QString query = QStringLiteral(R"(
 {
 "query": "
 query {
   repository(owner: \"%1\", name:\"%2\") {
-    issues(first: 100, states: OPEN, orderBy: {field: UPDATED_AT, direction: DESC}) {
+    issues(first: %3%4, states: OPEN, orderBy: {field: UPDATED_AT, direction: DESC}) {
+      pageInfo {
+        hasNextPage
+        endCursor
+      }
       nodes {
         number
         title
@@ -289,40 +339,25 @@ query {
   }
 }"
 }
-)").arg(m_org, m_repo);
+)").arg(m_org, m_repo).arg(pageSize).arg(after);
     query = query.replace('\n', ' ');
 
+    QPointer<IssuesModel> model(value);
     QNetworkReply *reply = sendQuery(query);
-    connect(reply, &QNetworkReply::finished, this, [this, issues_id, reply, value](){
+    connect(reply, &QNetworkReply::finished, this, [this, request_id, reply, model](){
+        reply->deleteLater();
+        if (!model || model->requestId() != request_id) return; // superseded
         if (reply->error() != QNetworkReply::NoError) {
             qWarning() << "Failed to fetch issues for" << this->m_org << this->m_repo;
             qWarning() << "Error: " << reply->errorString();
+            model->setFailed(request_id);
+            return;
         }
 
-        QByteArray data = reply->readAll();
-        QVariantList r = QJsonDocument::fromJson(data).object().
-                value("data").toObject().value("repository").toObject().
-                value("issues").toObject().value("nodes").toArray().toVariantList();
-
-        QVariantList rlist;
-        for (const auto &e: r) {
-            QVariantMap element = e.toMap();
-            QVariantMap m;
-            m["id"] = element.value("number");
-            m["author"] = getName(element.value("author"));
-            m["commentsCount"] = element.value("comments").toMap().value("totalCount").toInt();
-            m["number"] = element.value("number");
-            m["title"] = element.value("title");
-            m["created"] = parseDate(element.value("createdAt").toString(), true);
-            m["updated"] = parseDate(element.value("updatedAt").toString(), true);
-            rlist.append(m);
-        }
-
-        QVariantMap result;
-        result["issues"] = rlist;
-        value->setValue(issues_id, result);
-
-        reply->deleteLater();
+        parseAsync<IssuesPage>(reply->readAll(), &ProjectGitHub::parseIssues,
+                               [request_id, model](const IssuesPage &result) {
+            if (model) model->appendPage(request_id, result.items, result.next_cursor);
+        });
     });
 }
 
@@ -354,42 +389,58 @@ query {
 
     QNetworkReply *reply = sendQuery(query);
     connect(reply, &QNetworkReply::finished, this, [this, release_id, reply, value](){
+        if (value->valueId() != release_id) {
+            reply->deleteLater();
+            return; // superseded by another request
+        }
         if (reply->error() != QNetworkReply::NoError) {
             qWarning() << "Failed to fetch release for" << this->m_org << this->m_repo;
             qWarning() << "Error: " << reply->errorString();
+            value->setValue(release_id, QVariantMap{});
+            reply->deleteLater();
+            return;
         }
 
-        QByteArray data = reply->readAll();
-        QVariantMap r = QJsonDocument::fromJson(data).object().
-                value("data").toObject().value("repository").toObject().
-                value("release").toObject().toVariantMap();
-
-        QVariantMap result;
-        QString name = r.value("name").toString();
-        QString description = r.value("descriptionHTML").toString();
-        result["name"] = name.isEmpty() ? release_id : name;
-        result["description"] = description.isEmpty() ?
-              r.value("tagCommit").toMap().value("message") :
-              description;
-        result["datetime"] = parseDate(r.value("createdAt").toString());
-
-        value->setValue(release_id, result);
+        QPointer<LoadableObject> target(value);
+        parseAsync<QVariantMap>(reply->readAll(), [release_id](const QByteArray &data) {
+            QVariantMap r = QJsonDocument::fromJson(data).object().
+                    value("data").toObject().value("repository").toObject().
+                    value("release").toObject().toVariantMap();
+
+            QVariantMap result;
+            QString name = r.value("name").toString();
+            QString description = r.value("descriptionHTML").toString();
+            result["name"] = name.isEmpty() ? release_id : name;
+            result["description"] = description.isEmpty() ?
+                  r.value("tagCommit").toMap().value("message") :
+                  description;
+            result["datetime"] = parseDate(r.value("createdAt").toString());
+
+            return result;
+        }, [release_id, target](const QVariantMap &result) {
+            if (target) target->setValue(release_id, result);
+        });
         reply->deleteLater();
     });
 }
 
 
-void ProjectGitHub::releases(LoadableObject *value) {
-    const QString releases_id{QStringLiteral("releases")};
-    value->reset(releases_id);
+void ProjectGitHub::releases(ReleasesModel *value) {
+    const QString request_id = value->requestId();
+    const QString after = value->cursor().isEmpty() ? QString{} :
+                                                      QStringLiteral(", after: \\\"%1\\\"").arg(value->cursor());
 
     QString query = QStringLiteral(R"(
 {
 "query": "
 query {
   repository(owner: \"%1\", name:\"%2\") {
-    releases(first: 30, orderBy: {field: CREATED_AT, direction: DESC}) {
+    releases(first: %3%4, orderBy: {field: CREATED_AT, direction: DESC}) {
       totalCount
+      pageInfo {
+        hasNextPage
+        endCursor
+      }
       nodes {
         createdAt
         name
@@ -399,37 +450,46 @@ query {
   }
 }"
 }
-)").arg(m_org, m_repo);
+)").arg(m_org, m_repo).arg(pageSize).arg(after);
     query = query.replace('\n', ' ');
 
+    QPointer<ReleasesModel> model(value);
     QNetworkReply *reply = sendQuery(query);
-    connect(reply, &QNetworkReply::finished, this, [this, releases_id, reply, value](){
+    connect(reply, &QNetworkReply::finished, this, [this, request_id, reply, model](){
+        reply->deleteLater();
+        if (!model || model->requestId() != request_id) return; // superseded
         if (reply->error() != QNetworkReply::NoError) {
             qWarning() << "Failed to fetch releases for" << this->m_org << this->m_repo;
             qWarning() << "Error: " << reply->errorString();
+            model->setFailed(request_id);
+            return;
         }
 
-        QByteArray data = reply->readAll();
-        QVariantList r = QJsonDocument::fromJson(data).object().
-                value("data").toObject().value("repository").toObject().
-                value("releases").toObject().value("nodes").toArray().toVariantList();
-
-        QVariantList rlist;
-        for (const auto &e: r) {
-            QVariantMap element = e.toMap();
-            QVariantMap m;
-            QString name = element.value("name").toString();
-            QString tagName = element.value("tagName").toString();
-            m["id"] = tagName;
-            m["name"] = name.isEmpty() ? tagName : name;
-            m["datetime"] = parseDate(element.value("createdAt").toString());
-            rlist.append(m);
-        }
+        parseAsync<ReleasesPage>(reply->readAll(), [](const QByteArray &data) {
+            QJsonObject releases = QJsonDocument::fromJson(data).object().
+                    value("data").toObject().value("repository").toObject().
+                    value("releases").toObject();
+            const QJsonArray r = releases.value("nodes").toArray();
+            QJsonObject page = releases.value("pageInfo").toObject();
+
+            QVector<ReleaseItem> rlist;
+            rlist.reserve(r.size());
+            for (const QJsonValue &e: r) {
+                QJsonObject element = e.toObject();
+                ReleaseItem m;
+                QString name = element.value("name").toString();
+                QString tagName = element.value("tagName").toString();
+                m.id = tagName;
+                m.name = name.isEmpty() ? tagName : name;
+                m.datetime = DateFormatter::parse(element.value("createdAt").toString());
+                rlist.append(m);
+            }
 
-        QVariantMap result;
-        result["releases"] = rlist;
-        value->setValue(releases_id, result);
+            const QString next = page.value("hasNextPage").toBool() ? page.value("endCursor").toString() : QString{};
 
-        reply->deleteLater();
+            return ReleasesPage{rlist, next};
+        }, [request_id, model](const ReleasesPage &result) {
+            if (model) model->appendPage(request_id, result.items, result.next_cursor);
+        });
     });
 }
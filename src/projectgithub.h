@@ -13,11 +13,12 @@ public:
     explicit ProjectGitHub(const QString &url, ChumPackage *package);
 
     static bool isProject(const QString &url);
+    static IssuesPage parseIssues(const QByteArray &data);
 
     virtual void issue(const QString &id, LoadableObject *value) override;
-    virtual void issues(LoadableObject *value) override;
+    virtual void issues(IssuesModel *value) override;
     virtual void release(const QString &id, LoadableObject *value) override;
-    virtual void releases(LoadableObject *value) override;
+    virtual void releases(ReleasesModel *value) override;
 
 signals:
 
@@ -1,6 +1,7 @@
 #include "projectgitlab.h"
 #include "chumpackage.h"
 #include "main.h"
+#include "tracer.h"
 
 #include <QDebug>
 #include <QJsonArray>
@@ -10,6 +11,7 @@
 #include <QLocale>
 #include <QNetworkRequest>
 #include <QNetworkReply>
+#include <QPointer>
 #include <QSharedPointer>
 #include <QUrl>
 #include <QVariantList>
@@ -20,10 +22,10 @@ QMap<QString, QString> ProjectGitLab::s_sites;
 //////////////////////////////////////////////////////
 /// helper functions
 
-static QString getName(const QVariant &v) {
-  QVariantMap m = v.toMap();
-  QString login = m[QLatin1String("username")].toString();
-  QString name = m[QLatin1String("name")].toString();
+static QString getName(const QJsonValue &v) {
+  QJsonObject m = v.toObject();
+  QString login = m.value(QLatin1String("username")).toString();
+  QString name = m.value(QLatin1String("name")).toString();
   if (login.isEmpty() || name==login) return name;
   if (name.isEmpty()) return login;
   return QStringLiteral("%1 (%2)").arg(name, login);
@@ -72,6 +74,12 @@ void ProjectGitLab::initSites() {
   }
 }
 
+// static
+QStringList ProjectGitLab::hosts() {
+  initSites();
+  return s_sites.keys();
+}
+
 // static
 bool ProjectGitLab::isProject(const QString &url) {
   initSites();
@@ -80,14 +88,17 @@ bool ProjectGitLab::isProject(const QString &url) {
   return s_sites.contains(h);
 }
 
-QNetworkReply* ProjectGitLab::sendQuery(const QString &query) {
+QNetworkReply* ProjectGitLab::sendQuery(const QString &query, const RequestPolicy &policy) {
   QString reqAuth = QStringLiteral("Bearer %1").arg(m_token);
   QString reqUrl = QStringLiteral("https://%1/api/graphql").arg(m_host);
   QNetworkRequest request;
   request.setUrl(reqUrl);
   request.setRawHeader("Content-Type", "application/json");
   request.setRawHeader("Authorization", reqAuth.toLocal8Bit());
-  return nMng->post(request, query.toLocal8Bit());
+  // GraphQL queries do not modify data and can be repeated
+  QNetworkReply *reply = ForgeReply::post(request, query.toLocal8Bit(), QStringLiteral("gitlab"), policy);
+  Tracer::instance()->traceReply(reply, QStringLiteral("gitlab"));
+  return reply;
 }
 
 void ProjectGitLab::fetchRepoInfo() {
@@ -111,31 +122,31 @@ query {
 )").arg(m_path);
   query = query.replace('\n', ' ');
 
-  QNetworkReply *reply = sendQuery(query);
+  QNetworkReply *reply = sendQuery(query, RequestPolicy::background());
   connect(reply, &QNetworkReply::finished, this, [this, reply](){
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "GitLab: Failed to fetch repository data for GitLab" << this->m_path;
       qWarning() << "GitLab: Error: " << reply->errorString();
     }
 
-    QByteArray data = reply->readAll();
-    QJsonObject r{QJsonDocument::fromJson(data).object().
-          value("data").toObject().value("project").toObject()};
-
-    int vi;
+    parseAsync<QJsonObject>(reply->readAll(), [](const QByteArray &data) {
+      return QJsonDocument::fromJson(data).object().
+            value("data").toObject().value("project").toObject();
+    }, [this](const QJsonObject &r) {
+      int vi;
 
-    vi = r.value("starCount").toInt(-1);
-    if (vi>=0) m_package->setStarsCount(vi);
+      vi = r.value("starCount").toInt(-1);
+      if (vi>=0) m_package->setStarsCount(vi);
 
-    vi = r.value("forksCount").toInt(-1);
-    if (vi>=0) m_package->setForksCount(vi);
+      vi = r.value("forksCount").toInt(-1);
+      if (vi>=0) m_package->setForksCount(vi);
 
-    vi = r.value("openIssuesCount").toInt(-1);
-    if (vi>=0) m_package->setIssuesCount(vi);
-
-    vi = r.value("releases").toObject().value("count").toInt(-1);
-    if (vi>=0) m_package->setReleasesCount(vi);
+      vi = r.value("openIssuesCount").toInt(-1);
+      if (vi>=0) m_package->setIssuesCount(vi);
 
+      vi = r.value("releases").toObject().value("count").toInt(-1);
+      if (vi>=0) m_package->setReleasesCount(vi);
+    });
     reply->deleteLater();
   });
 }
@@ -182,57 +193,71 @@ query {
 
   QNetworkReply *reply = sendQuery(query);
   connect(reply, &QNetworkReply::finished, this, [this, issue_id, reply, value](){
+    if (value->valueId() != issue_id) {
+      reply->deleteLater();
+      return; // superseded by another request
+    }
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "GitLab: Failed to fetch issue for" << this->m_path;
       qWarning() << "GitLab: Error: " << reply->errorString();
+      value->setValue(issue_id, QVariantMap{});
+      reply->deleteLater();
+      return;
     }
 
-    QByteArray data = reply->readAll();
-    QVariantMap r = QJsonDocument::fromJson(data).object().
-          value("data").toObject().value("project").toObject().
-          value("issue").toObject().toVariantMap();
-
-    QVariantMap result;
-    result["id"] = r.value("iid");
-    result["number"] = r.value("iid");
-    result["title"] = r.value("title");
-    QVariantList clist = r.value("notes").toMap().value("nodes").toList();
-    QVariantList result_list;
-    result["commentsCount"] = clist.size();
-    QVariantMap m;
-    m["author"] = getName(r.value("author"));
-    m["created"] = parseDate(r.value("createdAt").toString(), true);
-    m["updated"] = parseDate(r.value("updatedAt").toString(), true);
-    m["body"] = r.value("descriptionHtml").toString();
-    result_list.append(m);
-    // iterate in reverse as gitlab returns notes in reverse order
-    for (auto e=clist.rbegin(); e!=clist.rend(); ++e) {
-      QVariantMap element = e->toMap();
-      m.clear();
-      m["author"] = getName(element.value("author"));
-      m["created"] = parseDate(element.value("createdAt").toString(), true);
-      m["updated"] = parseDate(element.value("updatedAt").toString(), true);
-      m["body"] = element.value("bodyHtml").toString();
-      result_list.append(m);
-    }
+    QPointer<LoadableObject> target(value);
+    parseAsync<QVariantMap>(reply->readAll(), [](const QByteArray &data) {
+      QJsonObject r = QJsonDocument::fromJson(data).object().
+            value("data").toObject().value("project").toObject().
+            value("issue").toObject();
+
+      QVariantMap result;
+      result["id"] = r.value("iid").toString();
+      result["number"] = r.value("iid").toString();
+      result["title"] = r.value("title").toString();
+      const QJsonArray clist = r.value("notes").toObject().value("nodes").toArray();
+      result["commentsCount"] = clist.size();
+      Discussion discussion;
+      discussion.reserve(clist.size() + 1);
+      discussion.append(CommentItem{getName(r.value("author")),
+                                    r.value("descriptionHtml").toString(),
+                                    DateFormatter::parse(r.value("createdAt").toString()),
+                                    DateFormatter::parse(r.value("updatedAt").toString())});
+      // iterate in reverse as gitlab returns notes in reverse order
+      for (int i=clist.size()-1; i >= 0; --i) {
+        QJsonObject element = clist.at(i).toObject();
+        discussion.append(CommentItem{getName(element.value("author")),
+                                      element.value("bodyHtml").toString(),
+                                      DateFormatter::parse(element.value("createdAt").toString()),
+                                      DateFormatter::parse(element.value("updatedAt").toString())});
+      }
 
-    result["discussion"] = result_list;
-    value->setValue(issue_id, result);
+      result["discussion"] = QVariant::fromValue(discussion);
+
+      return result;
+    }, [issue_id, target](const QVariantMap &result) {
+      if (target) target->setValue(issue_id, result);
+    });
     reply->deleteLater();
   });
 }
 
 
-void ProjectGitLab::issues(LoadableObject *value) {
-  const QString issues_id{QStringLiteral("issues")};
-  value->reset(issues_id);
+void ProjectGitLab::issues(IssuesModel *value) {
+  const QString request_id = value->requestId();
+  const QString after = value->cursor().isEmpty() ? QString{} :
+                                                    QStringLiteral(", after: \\\"%1\\\"").arg(value->cursor());
 
   QString query = QStringLiteral(R"(
 {
 "query": "
 query {
   project(fullPath: \"%1\") {
-    issues(state: opened, sort: UPDATED_DESC) {
+    issues(state: opened, sort: UPDATED_DESC, first: %2%3) {
+      pageInfo {
+        hasNextPage
+        endCursor
+      }
       nodes {
         iid
         title
@@ -242,50 +267,54 @@ query {
         }
         createdAt
         updatedAt
-        notes {
-          nodes {
-            createdAt
-          }
-        }
+        userNotesCount
       }
     }
   }
 }"
 }
-)").arg(m_path);
+)").arg(m_path).arg(pageSize).arg(after);
   query = query.replace('\n', ' ');
 
+  QPointer<IssuesModel> model(value);
   QNetworkReply *reply = sendQuery(query);
-  connect(reply, &QNetworkReply::finished, this, [this, issues_id, reply, value](){
+  connect(reply, &QNetworkReply::finished, this, [this, request_id, reply, model](){
+    reply->deleteLater();
+    if (!model || model->requestId() != request_id) return; // superseded
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "GitLab: Failed to fetch issues for" << this->m_path;
       qWarning() << "GitLab: Error: " << reply->errorString();
+      model->setFailed(request_id);
+      return;
     }
 
-    QByteArray data = reply->readAll();
-    QVariantList r = QJsonDocument::fromJson(data).object().
-          value("data").toObject().value("project").toObject().
-          value("issues").toObject().value("nodes").toArray().toVariantList();
-
-    QVariantList rlist;
-    for (const auto &e: r) {
-      QVariantMap element = e.toMap();
-      QVariantMap m;
-      m["id"] = element.value("iid");
-      m["author"] = getName(element.value("author"));
-      m["commentsCount"] = element.value("notes").toMap().value("nodes").toList().size();
-      m["number"] = element.value("iid");
-      m["title"] = element.value("title");
-      m["created"] = parseDate(element.value("createdAt").toString(), true);
-      m["updated"] = parseDate(element.value("updatedAt").toString(), true);
-      rlist.append(m);
-    }
+    parseAsync<IssuesPage>(reply->readAll(), [](const QByteArray &data) {
+      QJsonObject issues = QJsonDocument::fromJson(data).object().
+            value("data").toObject().value("project").toObject().
+            value("issues").toObject();
+      const QJsonArray r = issues.value("nodes").toArray();
+      QJsonObject page = issues.value("pageInfo").toObject();
+
+      QVector<IssueItem> rlist;
+      rlist.reserve(r.size());
+      for (const QJsonValue &e: r) {
+        QJsonObject element = e.toObject();
+        IssueItem m;
+        m.number = element.value("iid").toString();
+        m.author = getName(element.value("author"));
+        m.comments_count = element.value("userNotesCount").toInt();
+        m.title = element.value("title").toString();
+        m.created = DateFormatter::parse(element.value("createdAt").toString());
+        m.updated = DateFormatter::parse(element.value("updatedAt").toString());
+        rlist.append(m);
+      }
 
-    QVariantMap result;
-    result["issues"] = rlist;
-    value->setValue(issues_id, result);
+      const QString next = page.value("hasNextPage").toBool() ? page.value("endCursor").toString() : QString{};
 
-    reply->deleteLater();
+      return IssuesPage{rlist, next};
+    }, [request_id, model](const IssuesPage &result) {
+      if (model) model->appendPage(request_id, result.items, result.next_cursor);
+    });
   });
 }
 
@@ -314,37 +343,53 @@ query {
 
   QNetworkReply *reply = sendQuery(query);
   connect(reply, &QNetworkReply::finished, this, [this, release_id, reply, value](){
+    if (value->valueId() != release_id) {
+      reply->deleteLater();
+      return; // superseded by another request
+    }
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "GitLab: Failed to fetch release for" << this->m_path;
       qWarning() << "GitLab: Error: " << reply->errorString();
+      value->setValue(release_id, QVariantMap{});
+      reply->deleteLater();
+      return;
     }
 
-    QByteArray data = reply->readAll();
-    QVariantMap r = QJsonDocument::fromJson(data).object().
-          value("data").toObject().value("project").toObject().
-          value("release").toObject().toVariantMap();
-
-    QVariantMap result;
-    result["name"] = r.value("name");
-    result["description"] = r.value("descriptionHtml");
-    result["datetime"] = parseDate(r.value("createdAt").toString());
-
-    value->setValue(release_id, result);
+    QPointer<LoadableObject> target(value);
+    parseAsync<QVariantMap>(reply->readAll(), [](const QByteArray &data) {
+      QVariantMap r = QJsonDocument::fromJson(data).object().
+            value("data").toObject().value("project").toObject().
+            value("release").toObject().toVariantMap();
+
+      QVariantMap result;
+      result["name"] = r.value("name");
+      result["description"] = r.value("descriptionHtml");
+      result["datetime"] = parseDate(r.value("createdAt").toString());
+
+      return result;
+    }, [release_id, target](const QVariantMap &result) {
+      if (target) target->setValue(release_id, result);
+    });
     reply->deleteLater();
   });
 }
 
 
-void ProjectGitLab::releases(LoadableObject *value) {
-  const QString releases_id{QStringLiteral("releases")};
-  value->reset(releases_id);
+void ProjectGitLab::releases(ReleasesModel *value) {
+  const QString request_id = value->requestId();
+  const QString after = value->cursor().isEmpty() ? QString{} :
+                                                    QStringLiteral(", after: \\\"%1\\\"").arg(value->cursor());
 
   QString query = QStringLiteral(R"(
 {
 "query": "
 query {
   project(fullPath: \"%1\") {
-    releases {
+    releases(sort: RELEASED_AT_DESC, first: %2%3) {
+      pageInfo {
+        hasNextPage
+        endCursor
+      }
       nodes {
         name
         tagName
@@ -354,35 +399,44 @@ query {
   }
 }"
 }
-)").arg(m_path);
+)").arg(m_path).arg(pageSize).arg(after);
   query = query.replace('\n', ' ');
 
+  QPointer<ReleasesModel> model(value);
   QNetworkReply *reply = sendQuery(query);
-  connect(reply, &QNetworkReply::finished, this, [this, releases_id, reply, value](){
+  connect(reply, &QNetworkReply::finished, this, [this, request_id, reply, model](){
+    reply->deleteLater();
+    if (!model || model->requestId() != request_id) return; // superseded
     if (reply->error() != QNetworkReply::NoError) {
       qWarning() << "GitLab: Failed to fetch releases for" << this->m_path;
       qWarning() << "GitLab: Error: " << reply->errorString();
+      model->setFailed(request_id);
+      return;
     }
 
-    QByteArray data = reply->readAll();
-    QVariantList r = QJsonDocument::fromJson(data).object().
-          value("data").toObject().value("project").toObject().
-          value("releases").toObject().value("nodes").toArray().toVariantList();
-
-    QVariantList rlist;
-    for (const auto &e: r) {
-      QVariantMap element = e.toMap();
-      QVariantMap m;
-      m["id"] = element.value("tagName");
-      m["name"] = element.value("name");
-      m["datetime"] = parseDate(element.value("createdAt").toString());
-      rlist.append(m);
-    }
+    parseAsync<ReleasesPage>(reply->readAll(), [](const QByteArray &data) {
+      QJsonObject releases = QJsonDocument::fromJson(data).object().
+            value("data").toObject().value("project").toObject().
+            value("releases").toObject();
+      const QJsonArray r = releases.value("nodes").toArray();
+      QJsonObject page = releases.value("pageInfo").toObject();
+
+      QVector<ReleaseItem> rlist;
+      rlist.reserve(r.size());
+      for (const QJsonValue &e: r) {
+        QJsonObject element = e.toObject();
+        ReleaseItem m;
+        m.id = element.value("tagName").toString();
+        m.name = element.value("name").toString();
+        m.datetime = DateFormatter::parse(element.value("createdAt").toString());
+        rlist.append(m);
+      }
 
-    QVariantMap result;
-    result["releases"] = rlist;
-    value->setValue(releases_id, result);
+      const QString next = page.value("hasNextPage").toBool() ? page.value("endCursor").toString() : QString{};
 
-    reply->deleteLater();
+      return ReleasesPage{rlist, next};
+    }, [request_id, model](const ReleasesPage &result) {
+      if (model) model->appendPage(request_id, result.items, result.next_cursor);
+    });
   });
 }
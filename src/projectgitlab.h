@@ -5,6 +5,7 @@
 #include <QNetworkReply>
 #include <QString>
 
+#include "forgereply.h"
 #include "projectabstract.h"
 
 class ProjectGitLab : public ProjectAbstract
@@ -14,16 +15,18 @@ public:
     explicit ProjectGitLab(const QString &url, ChumPackage *package);
 
     static bool isProject(const QString &url);
+    static QStringList hosts();
 
     virtual void issue(const QString &id, LoadableObject *value) override;
-    virtual void issues(LoadableObject *value) override;
+    virtual void issues(IssuesModel *value) override;
     virtual void release(const QString &id, LoadableObject *value) override;
-    virtual void releases(LoadableObject *value) override;
+    virtual void releases(ReleasesModel *value) override;
 
 signals:
 
 private:
-    QNetworkReply* sendQuery(const QString &query);
+    QNetworkReply* sendQuery(const QString &query,
+                             const RequestPolicy &policy = RequestPolicy::interactive());
     void fetchRepoInfo();
 
     static void initSites();
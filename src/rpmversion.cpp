@@ -0,0 +1,124 @@
+#include "rpmversion.h"
+
+// character classes of rpm are limited to ASCII
+static bool isDigit(QChar c) { return c >= QLatin1Char('0') && c <= QLatin1Char('9'); }
+static bool isAlpha(QChar c) {
+    return (c >= QLatin1Char('a') && c <= QLatin1Char('z')) ||
+            (c >= QLatin1Char('A') && c <= QLatin1Char('Z'));
+}
+static bool isAlnum(QChar c) { return isDigit(c) || isAlpha(c); }
+
+int RpmVersion::compare(const QString &a, const QString &b) {
+    if (a == b) return 0;
+
+    const int na = a.size();
+    const int nb = b.size();
+    int one = 0;
+    int two = 0;
+
+    // characters past the end are treated as terminating null
+    auto at = [](const QString &s, int i) { return i < s.size() ? s.at(i) : QChar{}; };
+
+    while (one < na || two < nb) {
+        // skip separators, '~' and '^' are handled below
+        while (one < na && !isAlnum(a.at(one)) && a.at(one) != QLatin1Char('~') && a.at(one) != QLatin1Char('^'))
+            ++one;
+        while (two < nb && !isAlnum(b.at(two)) && b.at(two) != QLatin1Char('~') && b.at(two) != QLatin1Char('^'))
+            ++two;
+
+        // tilde sorts before everything else, including the end of string
+        const QChar ca = at(a, one);
+        const QChar cb = at(b, two);
+        if (ca == QLatin1Char('~') || cb == QLatin1Char('~')) {
+            if (ca != QLatin1Char('~')) return 1;
+            if (cb != QLatin1Char('~')) return -1;
+            ++one;
+            ++two;
+            continue;
+        }
+
+        // caret sorts after the end of string, but before anything else
+        if (ca == QLatin1Char('^') || cb == QLatin1Char('^')) {
+            if (one >= na) return -1;
+            if (two >= nb) return 1;
+            if (ca != QLatin1Char('^')) return 1;
+            if (cb != QLatin1Char('^')) return -1;
+            ++one;
+            ++two;
+            continue;
+        }
+
+        if (one >= na || two >= nb) break;
+
+        // take the next segment of the same class from both strings
+        int end_one = one;
+        int end_two = two;
+        const bool is_num = isDigit(a.at(one));
+        if (is_num) {
+            while (end_one < na && isDigit(a.at(end_one))) ++end_one;
+            while (end_two < nb && isDigit(b.at(end_two))) ++end_two;
+        } else {
+            while (end_one < na && isAlpha(a.at(end_one))) ++end_one;
+            while (end_two < nb && isAlpha(b.at(end_two))) ++end_two;
+        }
+
+        // segments of different classes, numeric one is newer
+        if (end_two == two) return is_num ? 1 : -1;
+
+        if (is_num) {
+            // leading zeros are ignored, longer number is larger
+            while (one < end_one - 1 && a.at(one) == QLatin1Char('0')) ++one;
+            while (two < end_two - 1 && b.at(two) == QLatin1Char('0')) ++two;
+            if (end_one - one > end_two - two) return 1;
+            if (end_one - one < end_two - two) return -1;
+        }
+
+        const int rc = QStringRef(&a, one, end_one - one).compare(QStringRef(&b, two, end_two - two));
+        if (rc != 0) return rc < 0 ? -1 : 1;
+
+        one = end_one;
+        two = end_two;
+    }
+
+    if (one >= na && two >= nb) return 0;
+    // string with remaining segments is newer
+    return one >= na ? -1 : 1;
+}
+
+// splits "[epoch:]version[-release]", missing epoch is 0
+static void splitEvr(const QString &evr, QString &epoch, QString &version, QString &release) {
+    int start = 0;
+    const int colon = evr.indexOf(QLatin1Char(':'));
+    if (colon >= 0) {
+        epoch = evr.left(colon);
+        start = colon + 1;
+    }
+    if (epoch.isEmpty())
+        epoch = QStringLiteral("0");
+
+    const int dash = evr.lastIndexOf(QLatin1Char('-'));
+    if (dash >= start) {
+        version = evr.mid(start, dash - start);
+        release = evr.mid(dash + 1);
+    } else {
+        version = evr.mid(start);
+        release.clear();
+    }
+}
+
+int RpmVersion::compareEvr(const QString &a, const QString &b) {
+    if (a == b) return 0;
+
+    QString epoch_a, version_a, release_a;
+    QString epoch_b, version_b, release_b;
+    splitEvr(a, epoch_a, version_a, release_a);
+    splitEvr(b, epoch_b, version_b, release_b);
+
+    int rc = compare(epoch_a, epoch_b);
+    if (rc != 0) return rc;
+    rc = compare(version_a, version_b);
+    if (rc != 0) return rc;
+    // as in rpm, release is only compared if given for both
+    if (release_a.isEmpty() || release_b.isEmpty()) return 0;
+    return compare(release_a, release_b);
+}
@@ -0,0 +1,17 @@
+#ifndef RPMVERSION_H
+#define RPMVERSION_H
+
+#include <QString>
+
+/// Comparison of RPM versions following the rules of rpmvercmp, used to
+/// find updates locally from the available and installed package IDs.
+class RpmVersion
+{
+public:
+    // compares version or release strings, returns -1, 0 or 1
+    static int compare(const QString &a, const QString &b);
+    // compares "[epoch:]version[-release]" as given in PackageKit IDs
+    static int compareEvr(const QString &a, const QString &b);
+};
+
+#endif // RPMVERSION_H
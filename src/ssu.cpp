@@ -1,5 +1,7 @@
 #include "ssu.h"
+#include "stallwatchdog.h"
 
+#include <QDBusMessage>
 #include <QDBusPendingCall>
 #include <QDBusPendingReply>
 #include <QDebug>
@@ -23,6 +25,10 @@ static QString s_repo_testing_alias(
 static QString s_repo_testing_prefix(
         QStringLiteral("https://repo.sailfishos.org/obs/sailfishos:/chum:/testing/"));
 
+// updateRepos talks to the network and can take much longer than the default D-Bus timeout
+static const int s_timeout_default{-1};
+static const int s_timeout_update{5*60*1000};
+
 Ssu::Ssu(QObject *parent) :
     QDBusAbstractInterface(
         QStringLiteral("org.nemo.ssu"),
@@ -33,7 +39,25 @@ Ssu::Ssu(QObject *parent) :
 {
 }
 
+// URL of the repository as given to SSU, with the release and
+// architecture filled in by SSU unless the version is set
+QString Ssu::repoTemplate(const QString &version, bool testing) {
+    QString url = testing ? s_repo_testing : s_repo_regular;
+    if (!version.isEmpty())
+        url = url.replace(QLatin1String(RELEASE_TAG), version);
+    return url;
+}
+
+QString Ssu::repoUrl() const {
+    const QString name = repoName();
+    if (name.isEmpty()) return QString{};
+    for (const auto &u: m_repos)
+        if (u.first == name) return u.second;
+    return QString{};
+}
+
 void Ssu::loadRepos() {
+    setStep(StepListRepos);
     // rnd set to false to have repos with the version instead of "latest"
     QDBusPendingCall pcall = asyncCall(QStringLiteral("listRepos"), false);
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(pcall, this);
@@ -42,6 +66,9 @@ void Ssu::loadRepos() {
 }
 
 void Ssu::onListFinished(QDBusPendingCallWatcher *call) {
+    StallWatchdog::Section section("ssu repositories");
+    call->deleteLater();
+    setStep(StepIdle);
     m_repos.clear();
 
     // load repos from DBus call
@@ -120,25 +147,104 @@ void Ssu::onListFinished(QDBusPendingCallWatcher *call) {
     emit updated();
 }
 
-void Ssu::setRepo(const QString &version, bool testing) {
+void Ssu::setStep(Step step) {
+    if (m_step == step) return;
+    m_step = step;
+    emit stepChanged();
+}
+
+/// Calls SSU method asynchronously and continues with `next` on success.
+/// On failure or cancellation, the steps done so far are rolled back, so
+/// that the previous repository is not left removed. If nothing has to
+/// be rolled back or the rollback itself fails, the list of repositories
+/// is reloaded to reflect the actual state of SSU.
+void Ssu::callStep(Step step, const QString &method, const QVariantList &args,
+                   int timeout, std::function<void()> next) {
+    if (m_cancelled) {
+        qWarning() << "SSU: Repository change cancelled before" << method;
+        emit cancelled();
+        rollback();
+        return;
+    }
+
+    setStep(step);
+    QDBusMessage msg = QDBusMessage::createMethodCall(service(), path(), interface(), method);
+    msg.setArguments(args);
+    QDBusPendingCall pcall = connection().asyncCall(msg, timeout);
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(pcall, this);
+    QObject::connect(watcher, &QDBusPendingCallWatcher::finished,
+                     this, [this, step, method, next](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
+        if (call->isError()) {
+            qWarning() << "SSU: Call" << method << "failed:" << call->error().message();
+            emit failed(call->error().message());
+            if (step != StepRestoreRepo && (m_removed || m_added)) {
+                rollback();
+                return;
+            }
+            // the failure is reported, not a missing repository after a successful call
+            m_added_repo_name.clear();
+            loadRepos();
+            return;
+        }
+        next();
+    });
+}
+
+/// Cancellation takes effect before the next step, a running call
+/// is completed first.
+void Ssu::cancel() {
+    if (!changing()) return;
+    m_cancelled = true;
+}
+
+/// Removes the added repository and adds the previous one again. The
+/// calls are chained without cancellation checks; a failure is reported
+/// and the repositories are reloaded as after any failed step.
+void Ssu::rollback() {
+    auto reload = [this]() { loadRepos(); };
+    auto updateRepos = [this, reload]() {
+        callStep(StepRestoreRepo, QStringLiteral("updateRepos"), QVariantList{},
+                 s_timeout_update, reload);
+    };
+    auto addPrevious = [this, updateRepos, reload]() {
+        if (!m_removed) {
+            reload();
+            return;
+        }
+        m_removed = false;
+        m_added_repo_name = m_previous_repo.first;
+        callStep(StepRestoreRepo, QStringLiteral("addRepo"),
+                 QVariantList{m_previous_repo.first, m_previous_repo.second},
+                 s_timeout_default, updateRepos);
+    };
+
+    m_cancelled = false;
+    m_version = m_previous_version;
+    if (m_added) {
+        const QString added = m_added_repo_name;
+        m_added = false;
+        m_added_repo_name.clear();
+        callStep(StepRestoreRepo, QStringLiteral("modifyRepo"), QVariantList{0, added},
+                 s_timeout_default, addPrevious);
+    } else
+        addPrevious();
+}
+
+bool Ssu::setRepo(const QString &version, bool testing) {
     if (!m_manage_repo) {
         qWarning() << "Cannot set repository via SSU - management disabled";
-        return;
+        return false;
     }
 
-    if (repoAvailable()) {
-        // remove current repository
-        callWithArgumentList(QDBus::BlockWithGui, QStringLiteral("modifyRepo"),
-                             QVariantList{0, m_repo_name});
+    if (m_step != StepIdle) {
+        qWarning() << "Cannot set repository via SSU - another operation is in progress";
+        return false;
     }
 
     // find new repo name
     QString rname = testing ? s_repo_testing_alias : s_repo_regular_alias;
-    QString url = testing ? s_repo_testing : s_repo_regular;
-
-    if (!version.isEmpty()) {
-        url = url.replace(QLatin1String(RELEASE_TAG), version);
-    }
+    QString url = repoTemplate(version, testing);
 
     if (rname != m_repo_name) {
         // check if proposed name is taken
@@ -147,19 +253,45 @@ void Ssu::setRepo(const QString &version, bool testing) {
                 qWarning() << "Expected free repository alias already taken - skipping management of repositories";
                 m_manage_repo = false;
                 emit updated();
-                return;
+                return false;
             }
         }
     }
 
-    m_repo_name.clear();
+    m_cancelled = false;
+    m_removed = false;
+    m_added = false;
+    m_previous_repo = std::make_pair(m_repo_name, repoTemplate(m_version, m_repo_testing));
+    m_previous_version = m_version;
+    m_version = version;
+
+    auto updateRepos = [this]() {
+        m_added = true;
+        callStep(StepUpdateRepos, QStringLiteral("updateRepos"), QVariantList{},
+                 s_timeout_update, [this]() {
+            // cancelled while updating
+            if (m_cancelled) {
+                emit cancelled();
+                rollback();
+            } else
+                loadRepos();
+        });
+    };
 
-    // add repo
-    callWithArgumentList(QDBus::BlockWithGui, QStringLiteral("addRepo"),
-                         QVariantList{rname, url});
-    call(QDBus::BlockWithGui, QStringLiteral("updateRepos"));
-    m_added_repo_name = rname;
+    auto addRepo = [this, rname, url, updateRepos]() {
+        m_removed = !m_previous_repo.first.isEmpty();
+        m_repo_name.clear();
+        // set before the call, so that a failed addition is detected when listing repositories
+        m_added_repo_name = rname;
+        callStep(StepAddRepo, QStringLiteral("addRepo"), QVariantList{rname, url},
+                 s_timeout_default, updateRepos);
+    };
 
-    // refresh list
-    loadRepos();
+    if (repoAvailable()) {
+        // remove current repository
+        callStep(StepRemoveRepo, QStringLiteral("modifyRepo"), QVariantList{0, m_repo_name},
+                 s_timeout_default, addRepo);
+    } else
+        addRepo();
+    return true;
 }
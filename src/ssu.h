@@ -4,35 +4,76 @@
 #include <QDBusAbstractInterface>
 #include <QDBusPendingCallWatcher>
 #include <QList>
+#include <functional>
 #include <utility>
 
 class Ssu : public QDBusAbstractInterface
 {
     Q_OBJECT
 public:
+    enum Step {
+        StepIdle,
+        StepRemoveRepo,
+        StepAddRepo,
+        StepUpdateRepos,
+        StepRestoreRepo,
+        StepListRepos
+    };
+    Q_ENUM(Step)
+
     explicit Ssu(QObject *parent = nullptr);
 
     bool manageRepo() const { return m_manage_repo; }
     bool repoAvailable() const { return m_manage_repo && !m_repo_name.isEmpty(); }
     bool repoTesting() const { return m_manage_repo && m_repo_testing; }
     QString repoName() const { return m_manage_repo ? m_repo_name : QString{}; }
+    QString repoUrl() const;
+    Step step() const { return m_step; }
+    // version the current repository was set up for, empty if automatic
+    void setVersion(const QString &version) { m_version = version; }
+    // true while a repository change is running and can be cancelled
+    bool changing() const { return m_step == StepRemoveRepo || m_step == StepAddRepo ||
+                m_step == StepUpdateRepos; }
 
     void loadRepos();
-    void setRepo(const QString &version=QString(), bool testing=false);
+    // returns false if the change was not started
+    bool setRepo(const QString &version=QString(), bool testing=false);
+    void cancel();
 
 signals:
     void updated();
+    void stepChanged();
+    // a step failed or the change was cancelled, the steps done so far
+    // are rolled back afterwards
+    void failed(QString details);
+    void cancelled();
 
 private:
     void onListFinished(QDBusPendingCallWatcher *call);
 
+    void callStep(Step step, const QString &method, const QVariantList &args,
+                  int timeout, std::function<void()> next);
+    void setStep(Step step);
+    void rollback();
+
+    static QString repoTemplate(const QString &version, bool testing);
+
 private:
     bool m_manage_repo{false};
     bool m_repo_testing{false};
+    bool m_cancelled{false};
+    Step m_step{StepIdle};
     QString m_repo_name;
 
     QList< std::pair<QString,QString> > m_repos;
     QString m_added_repo_name;
+
+    // state before the running change, restored on cancellation
+    QString m_version;
+    QString m_previous_version;
+    std::pair<QString,QString> m_previous_repo;
+    bool m_removed{false};
+    bool m_added{false};
 };
 
 #endif // SSU_H
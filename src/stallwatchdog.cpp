@@ -0,0 +1,189 @@
+#include "stallwatchdog.h"
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <algorithm>
+#include <functional>
+
+// upper bounds of latency histogram buckets, the last bucket is unbounded
+static const QVector<int> s_buckets_ms{16, 50, 100, 250, 500, 1000, 2500, 5000};
+// pause between pings and between checks of the active section during a stall
+static const int s_interval_ms{250};
+static const int s_poll_ms{50};
+// sections listed in the statistics
+static const int s_top_offenders{10};
+// stalls not attributed to an instrumented section
+static const char *s_unattributed{"unattributed"};
+
+static const QEvent::Type s_ping_event{QEvent::Type(QEvent::registerEventType())};
+
+StallWatchdog *StallWatchdog::s_instance{nullptr};
+
+namespace {
+class WatchdogThread : public QThread
+{
+public:
+    explicit WatchdogThread(std::function<void()> job) : m_job{job} {}
+
+protected:
+    void run() override { m_job(); }
+
+private:
+    std::function<void()> m_job;
+};
+}
+
+StallWatchdog::Section::Section(const char *name) {
+    StallWatchdog *w = StallWatchdog::instance();
+    QMutexLocker lock(&w->m_mutex);
+    w->m_sections.append(name);
+}
+
+StallWatchdog::Section::~Section() {
+    StallWatchdog *w = StallWatchdog::instance();
+    QMutexLocker lock(&w->m_mutex);
+    w->m_sections.removeLast();
+}
+
+StallWatchdog::StallWatchdog()
+    : QObject{}
+{
+    m_histogram.fill(0, s_buckets_ms.size() + 1);
+    const int threshold = qgetenv("CHUM_STALL_THRESHOLD_MS").toInt();
+    if (threshold > 0) m_threshold_ms = threshold;
+}
+
+StallWatchdog::~StallWatchdog() {
+    stop();
+}
+
+StallWatchdog* StallWatchdog::instance() {
+    if (!s_instance) s_instance = new StallWatchdog();
+    return s_instance;
+}
+
+void StallWatchdog::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!enabled) stop();
+}
+
+void StallWatchdog::start() {
+    if (m_thread || !m_enabled) return;
+    {
+        QMutexLocker lock(&m_mutex);
+        m_stop = false;
+    }
+    m_thread = new WatchdogThread([this]() { this->watch(); });
+    m_thread->start(QThread::LowPriority);
+}
+
+void StallWatchdog::stop() {
+    if (!m_thread) return;
+    {
+        QMutexLocker lock(&m_mutex);
+        m_stop = true;
+        m_wake.wakeAll();
+    }
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+}
+
+// ping handled by the main thread
+void StallWatchdog::customEvent(QEvent *event) {
+    if (event->type() != s_ping_event) return;
+    QMutexLocker lock(&m_mutex);
+    m_pong = m_ping;
+    m_wake.wakeAll();
+}
+
+void StallWatchdog::watch() {
+    QMutexLocker lock(&m_mutex);
+    while (!m_stop) {
+        const qint64 ping = ++m_ping;
+        QElapsedTimer timer;
+        timer.start();
+        QCoreApplication::postEvent(this, new QEvent(s_ping_event));
+
+        // wait for the main thread, sampling the running section once
+        // the threshold is exceeded
+        const char *section = nullptr;
+        while (!m_stop && m_pong < ping) {
+            const int wait = section ? s_poll_ms : m_threshold_ms;
+            if (!m_wake.wait(&m_mutex, wait) && m_pong < ping &&
+                    (!section || section == s_unattributed))
+                section = m_sections.isEmpty() ? s_unattributed : m_sections.last();
+        }
+        if (m_stop) break;
+
+        record(timer.elapsed(), section);
+        m_wake.wait(&m_mutex, s_interval_ms);
+    }
+}
+
+// called with the mutex locked
+void StallWatchdog::record(qint64 latency_ms, const char *section) {
+    ++m_pings;
+    int bucket = 0;
+    while (bucket < s_buckets_ms.size() && latency_ms > s_buckets_ms.at(bucket)) ++bucket;
+    ++m_histogram[bucket];
+
+    if (latency_ms < m_threshold_ms) return;
+    if (!section) section = s_unattributed;
+
+    ++m_stalls;
+    m_stalled_ms += latency_ms;
+    m_max_ms = qMax(m_max_ms, latency_ms);
+    Offender &o = m_offenders[QByteArray(section)];
+    ++o.stalls;
+    o.total_ms += latency_ms;
+    o.max_ms = qMax(o.max_ms, latency_ms);
+
+    qWarning() << "Event loop stalled for" << latency_ms << "ms in" << section;
+    Tracer *tracer = Tracer::instance();
+    tracer->complete(QStringLiteral("stall"), QStringLiteral("watchdog"),
+                     tracer->now() - latency_ms*1000,
+                     {{QStringLiteral("section"), QString::fromLatin1(section)}});
+}
+
+QVariantMap StallWatchdog::statistics() const {
+    QVariantList buckets;
+    for (int b: s_buckets_ms) buckets.append(b);
+
+    QMutexLocker lock(&m_mutex);
+    QVariantList histogram;
+    for (qint64 c: m_histogram) histogram.append(c);
+
+    // sections causing most of the stalled time
+    QList<QByteArray> names = m_offenders.keys();
+    std::sort(names.begin(), names.end(), [this](const QByteArray &a, const QByteArray &b) {
+        return m_offenders.value(a).total_ms > m_offenders.value(b).total_ms;
+    });
+    QVariantList offenders;
+    for (const QByteArray &name: names.mid(0, s_top_offenders)) {
+        const Offender o = m_offenders.value(name);
+        offenders.append(QVariantMap{
+                             {QStringLiteral("section"), QString::fromLatin1(name)},
+                             {QStringLiteral("stalls"), o.stalls},
+                             {QStringLiteral("totalMs"), o.total_ms},
+                             {QStringLiteral("maxMs"), o.max_ms}
+                         });
+    }
+
+    return QVariantMap{
+        {QStringLiteral("thresholdMs"), m_threshold_ms},
+        {QStringLiteral("bucketsMs"), buckets},
+        {QStringLiteral("histogram"), histogram},
+        {QStringLiteral("pings"), m_pings},
+        {QStringLiteral("stalls"), m_stalls},
+        {QStringLiteral("stalledMs"), m_stalled_ms},
+        {QStringLiteral("maxMs"), m_max_ms},
+        {QStringLiteral("offenders"), offenders}
+    };
+}
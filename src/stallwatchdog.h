@@ -0,0 +1,94 @@
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QVariantMap>
+#include <QVector>
+#include <QWaitCondition>
+
+class QThread;
+
+/// Measures the latency of the main event loop from a helper thread.
+/// The helper posts an event to the main thread and waits for it to be
+/// handled. When the wait exceeds the threshold, the stall is attributed
+/// to the instrumented section running in the main thread, such as a
+/// refresh stage, a model reset or a JSON parse, and recorded with its
+/// duration. The watchdog is enabled only when diagnostics or a trace
+/// are written, as it wakes up the CPU periodically.
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Marks a section of the main thread while in scope. The name must
+    /// be a string literal.
+    class Section
+    {
+    public:
+        explicit Section(const char *name);
+        ~Section();
+
+    private:
+        Q_DISABLE_COPY(Section)
+    };
+
+    ~StallWatchdog();
+
+    bool enabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+
+    // start has no effect unless enabled
+    void start();
+    void stop();
+
+    int  threshold() const { return m_threshold_ms; }
+    void setThreshold(int ms) { m_threshold_ms = ms; }
+
+    // latency histogram, stalls and sections causing them
+    QVariantMap statistics() const;
+
+    // static public methods
+    static StallWatchdog* instance();
+
+protected:
+    void customEvent(QEvent *event) override;
+
+private:
+    StallWatchdog();
+
+    void watch(); // runs in the helper thread
+    void record(qint64 latency_ms, const char *section);
+
+    struct Offender {
+        qint64 stalls{0};
+        qint64 total_ms{0};
+        qint64 max_ms{0};
+    };
+
+private:
+    QThread *m_thread{nullptr};
+    bool     m_enabled{false};
+    int      m_threshold_ms{100};
+
+    // shared with the helper thread
+    mutable QMutex m_mutex;
+    QWaitCondition m_wake;
+    bool    m_stop{false};
+    qint64  m_ping{0};
+    qint64  m_pong{0};
+    QVector<const char*> m_sections;
+
+    QVector<qint64> m_histogram; // pings per latency bucket
+    qint64 m_pings{0};
+    qint64 m_stalls{0};
+    qint64 m_stalled_ms{0};
+    qint64 m_max_ms{0};
+    QHash<QByteArray, Offender> m_offenders;
+
+    // static
+    static StallWatchdog *s_instance;
+};
+
+#endif // STALLWATCHDOG_H
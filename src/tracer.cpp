@@ -0,0 +1,107 @@
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QNetworkReply>
+#include <QUrl>
+
+Tracer* Tracer::s_instance{nullptr};
+
+Tracer::Tracer()
+{
+    m_timer.start();
+}
+
+Tracer* Tracer::instance() {
+    if (!s_instance) s_instance = new Tracer();
+    return s_instance;
+}
+
+void Tracer::setFileName(const QString &filename) {
+    m_filename = filename;
+}
+
+void Tracer::complete(const QString &name, const QString &category, qint64 start,
+                      const QVariantMap &args) {
+    if (!enabled()) return;
+    const qint64 end = now();
+    QMutexLocker lock(&m_mutex);
+    m_events.append(Event{name, category, start, end - start, args});
+}
+
+void Tracer::counter(const QString &name, const QVariantMap &values) {
+    if (!enabled()) return;
+    const qint64 ts = now();
+    QMutexLocker lock(&m_mutex);
+    m_events.append(Event{name, QStringLiteral("counter"), ts, -1, values});
+}
+
+// static
+QVariantMap Tracer::memoryUsage() {
+    QVariantMap usage;
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return usage;
+    for (const QByteArray &line: file.readAll().split('\n')) {
+        if (!line.startsWith("VmRSS:") && !line.startsWith("VmHWM:")) continue;
+        const QList<QByteArray> fields = line.simplified().split(' ');
+        if (fields.size() < 2) continue;
+        const QString key = line.startsWith("VmRSS:") ? QStringLiteral("rss_kb") :
+                                                        QStringLiteral("peak_rss_kb");
+        usage.insert(key, fields.at(1).toLongLong());
+    }
+    return usage;
+}
+
+void Tracer::traceReply(QNetworkReply *reply, const QString &category) {
+    if (!enabled() || !reply) return;
+    const qint64 start = now();
+    QObject::connect(reply, &QNetworkReply::finished, reply, [this, reply, category, start]() {
+        this->complete(reply->url().host() + reply->url().path(), category, start, {
+                           {QStringLiteral("status"),
+                            reply->attribute(QNetworkRequest::HttpStatusCodeAttribute)},
+                           {QStringLiteral("error"), int(reply->error())},
+                           {QStringLiteral("bytes"), reply->bytesAvailable()}
+                       });
+    });
+}
+
+bool Tracer::save() const {
+    if (!enabled()) return false;
+
+    QJsonArray events;
+    {
+        QMutexLocker lock(&m_mutex);
+        for (const Event &e: m_events) {
+            QJsonObject o;
+            o.insert(QStringLiteral("name"), e.name);
+            o.insert(QStringLiteral("cat"), e.category);
+            o.insert(QStringLiteral("ph"), e.duration < 0 ? QStringLiteral("C") : QStringLiteral("X"));
+            o.insert(QStringLiteral("ts"), e.start);
+            if (e.duration >= 0)
+                o.insert(QStringLiteral("dur"), e.duration);
+            o.insert(QStringLiteral("pid"), QCoreApplication::applicationPid());
+            o.insert(QStringLiteral("tid"), 1);
+            if (!e.args.isEmpty())
+                o.insert(QStringLiteral("args"), QJsonObject::fromVariantMap(e.args));
+            events.append(o);
+        }
+    }
+
+    QFile file(m_filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to write trace to" << m_filename << file.errorString();
+        return false;
+    }
+    QJsonObject root;
+    root.insert(QStringLiteral("traceEvents"), events);
+    root.insert(QStringLiteral("displayTimeUnit"), QStringLiteral("ms"));
+    root.insert(QStringLiteral("metadata"), QJsonObject::fromVariantMap(memoryUsage()));
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    qDebug() << "Trace with" << events.size() << "events written to" << m_filename;
+    return true;
+}
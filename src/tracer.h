@@ -0,0 +1,59 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+
+class QNetworkReply;
+
+/// Records timed sections of the application, such as refresh stages,
+/// forge network requests and model resets, and exports them in the
+/// Chrome Trace Event format. Tracing is enabled by the command line
+/// option `--trace <file>` or the environment variable `CHUM_TRACE`.
+class Tracer
+{
+public:
+    bool enabled() const { return !m_filename.isEmpty(); }
+    QString fileName() const { return m_filename; }
+    void setFileName(const QString &filename);
+
+    // time since start of the tracer in microseconds
+    qint64 now() const { return m_timer.nsecsElapsed() / 1000; }
+
+    void complete(const QString &name, const QString &category, qint64 start,
+                  const QVariantMap &args = QVariantMap{});
+    void counter(const QString &name, const QVariantMap &values);
+    void traceReply(QNetworkReply *reply, const QString &category);
+    bool save() const;
+
+    // current and peak resident memory in kB, as reported by the kernel
+    static QVariantMap memoryUsage();
+
+    // static public methods
+    static Tracer* instance();
+
+private:
+    Tracer();
+
+    struct Event {
+        QString name;
+        QString category;
+        qint64  start;
+        qint64  duration; // negative for counter events
+        QVariantMap args;
+    };
+
+private:
+    QElapsedTimer  m_timer;
+    QString        m_filename;
+    QVector<Event> m_events;
+    mutable QMutex m_mutex;
+
+    // static
+    static Tracer* s_instance;
+};
+
+#endif // TRACER_H
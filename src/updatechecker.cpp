@@ -0,0 +1,142 @@
+#include "updatechecker.h"
+#include "packageid.h"
+#include "tracer.h"
+
+#include <PackageKit/Daemon>
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSharedPointer>
+#include <QStandardPaths>
+#include <QThread>
+
+using namespace PackageKit;
+
+UpdateChecker::UpdateChecker(QObject *parent)
+    : QObject{parent}
+{
+    m_timer.start();
+    connect(&m_ssu, &Ssu::updated, this, &UpdateChecker::getUpdates);
+}
+
+// Stored state younger than this is not refreshed by background checks
+static const int s_background_min_age{60*60};
+
+void UpdateChecker::start() {
+    if (m_background && skipBackgroundCheck()) {
+        emit finished(0);
+        return;
+    }
+    m_ssu.loadRepos();
+}
+
+bool UpdateChecker::skipBackgroundCheck() const {
+    const QDateTime last = QDateTime::fromString(
+                readState().value(QStringLiteral("timestamp")).toString(), Qt::ISODate);
+    if (last.isValid() && last.secsTo(QDateTime::currentDateTimeUtc()) < s_background_min_age) {
+        qDebug() << "Update state is recent, skipping check";
+        return true;
+    }
+
+    QFile loadavg(QStringLiteral("/proc/loadavg"));
+    if (loadavg.open(QIODevice::ReadOnly)) {
+        const double load = loadavg.readAll().split(' ').value(0).toDouble();
+        if (load > QThread::idealThreadCount()) {
+            qDebug() << "System is under load, skipping check:" << load;
+            return true;
+        }
+    }
+
+    QDBusMessage psm = QDBusMessage::createMethodCall(
+                QStringLiteral("com.nokia.mce"),
+                QStringLiteral("/com/nokia/mce/request"),
+                QStringLiteral("com.nokia.mce.request"),
+                QStringLiteral("get_psm_state"));
+    QDBusMessage reply = QDBusConnection::systemBus().call(psm, QDBus::Block, 1000);
+    if (reply.type() == QDBusMessage::ReplyMessage && reply.arguments().value(0).toBool()) {
+        qDebug() << "Power saving mode is active, skipping check";
+        return true;
+    }
+
+    return false;
+}
+
+void UpdateChecker::getUpdates() {
+    const QString repo = m_ssu.repoName();
+    if (repo.isEmpty()) {
+        qWarning() << "SailfishOS:Chum repository is not available, cannot check for updates";
+        emit finished(1);
+        return;
+    }
+
+    auto updates = QSharedPointer<QStringList>::create();
+    auto pktr = Daemon::getUpdates();
+    connect(pktr, &Transaction::package, this, [repo, updates](
+            [[maybe_unused]] int info,
+            const QString &packageID,
+            [[maybe_unused]] const QString &summary
+            ) {
+        const PackageId pkid(packageID);
+        if (pkid.data() == repo)
+            updates->append(pkid.name());
+    });
+    connect(pktr, &Transaction::errorCode, this,
+            [](PackageKit::Transaction::Error /*error*/, const QString &details) {
+        qWarning() << "Failed to check for updates" << details;
+    });
+    connect(pktr, &Transaction::finished, this, [this, repo, updates](Transaction::Exit status) {
+        if (status != Transaction::ExitSuccess) {
+            emit this->finished(1);
+            return;
+        }
+        QVariantMap metrics = Tracer::memoryUsage();
+        metrics.insert(QStringLiteral("runtime_ms"), m_timer.elapsed());
+        const bool ok = writeState(repo, *updates, metrics);
+        qDebug() << "Updates available:" << updates->size() << "in" << m_timer.elapsed() << "ms";
+        emit this->finished(ok ? 0 : 1);
+    });
+}
+
+// static
+QString UpdateChecker::stateFileName() {
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+            QStringLiteral("/sailfishos-chum-gui/updates.json");
+}
+
+// static
+QVariantMap UpdateChecker::readState() {
+    QFile file(stateFileName());
+    if (!file.open(QIODevice::ReadOnly)) return QVariantMap{};
+    return QJsonDocument::fromJson(file.readAll()).object().toVariantMap();
+}
+
+// static
+bool UpdateChecker::writeState(const QString &repo, const QStringList &updates,
+                               const QVariantMap &metrics) {
+    const QString filename = stateFileName();
+    QDir().mkpath(QFileInfo(filename).absolutePath());
+
+    QJsonObject state;
+    state.insert(QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    state.insert(QStringLiteral("repo"), repo);
+    state.insert(QStringLiteral("count"), updates.size());
+    state.insert(QStringLiteral("updates"), QJsonValue::fromVariant(updates));
+    if (!metrics.isEmpty())
+        state.insert(QStringLiteral("metrics"), QJsonObject::fromVariantMap(metrics));
+
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write update state to" << filename << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(state).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
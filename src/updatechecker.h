@@ -0,0 +1,48 @@
+#ifndef UPDATECHECKER_H
+#define UPDATECHECKER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include <QVariantMap>
+
+#include "ssu.h"
+
+/// Headless check for updates of packages from the SailfishOS:Chum
+/// repository. Only SSU and a single PackageKit getUpdates transaction
+/// are used, without QML or network access. The result is written into
+/// a small state file, which is read by the GUI on startup to show the
+/// number of updates without waiting for the full refresh.
+///
+/// In background mode, as used by the systemd user timer, the check is
+/// skipped if the stored state is recent, the system is under load or
+/// power saving mode is active.
+class UpdateChecker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit UpdateChecker(QObject *parent = nullptr);
+
+    void start();
+    void setBackground(bool background) { m_background = background; }
+
+    // state file handling, shared with the GUI
+    static QString stateFileName();
+    static QVariantMap readState();
+    static bool writeState(const QString &repo, const QStringList &updates,
+                           const QVariantMap &metrics = QVariantMap{});
+
+signals:
+    void finished(int exitCode);
+
+private:
+    void getUpdates();
+    bool skipBackgroundCheck() const;
+
+private:
+    Ssu           m_ssu;
+    QElapsedTimer m_timer;
+    bool          m_background{false};
+};
+
+#endif // UPDATECHECKER_H
@@ -0,0 +1,211 @@
+#include "chum.h"
+#include "chumpackage.h"
+#include "chumpackagesmodel.h"
+#include "performanceprofile.h"
+#include "projectgithub.h"
+#include "refreshrunner.h"
+#include "syntheticrepo.h"
+
+#include <PackageKit/Details>
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// Hot paths of the application: applying package details, model resets,
+// search while typing and parsing of forge responses. Catalogs for the
+// model are filled by refreshes against synthetic repositories, see
+// RefreshRunner. Results are written in a machine-readable form with
+//
+//   bench_chum -o bench_chum.csv,csv
+//
+// or -o bench_chum.xml,xml, as done by the benchmark target of the build.
+class BenchChum : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void setDetails_data();
+    void setDetails();
+    void modelReset_data();
+    void modelReset();
+    void search_data();
+    void search();
+    void parseIssues_data();
+    void parseIssues();
+
+private:
+    // refreshes Chum with a repository of the given size, if needed
+    bool catalog(int packages);
+
+private:
+    RefreshRunner m_runner;
+    bool          m_bus{false};
+};
+
+void BenchChum::initTestCase() {
+    m_bus = m_runner.init();
+    PerformanceProfile::instance()->setMode(PerformanceProfile::Standard);
+}
+
+void BenchChum::cleanup() {
+    PerformanceProfile::instance()->setMode(PerformanceProfile::Standard);
+}
+
+bool BenchChum::catalog(int packages) {
+    if (m_runner.packages() == packages) return true;
+    return m_runner.startServices(packages) && m_runner.refresh() &&
+            Chum::instance()->packages().size() == packages;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+void BenchChum::setDetails_data() {
+    QTest::addColumn<int>("packages");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+// details of all packages as delivered by the refresh
+void BenchChum::setDetails() {
+    QFETCH(int, packages);
+
+    const SyntheticRepo repo(QStringLiteral("sailfishos-chum"), packages);
+    QList<ChumPackage*> targets;
+    QList<PackageKit::Details> details;
+    for (const SyntheticRepo::Package &p: repo.packages()) {
+        const QString id = repo.availableId(p);
+        ChumPackage *package = new ChumPackage(p.name, this);
+        package->setPkidLatest(PackageId(id));
+        targets.append(package);
+        details.append(PackageKit::Details(QVariantMap{
+                                               {QStringLiteral("package-id"), id},
+                                               {QStringLiteral("summary"), p.summary},
+                                               {QStringLiteral("description"), p.description},
+                                               {QStringLiteral("url"), p.url},
+                                               {QStringLiteral("license"), p.license},
+                                               {QStringLiteral("size"), p.size}
+                                           }));
+    }
+
+    QBENCHMARK {
+        for (int i = 0; i < targets.size(); ++i)
+            targets.at(i)->setDetails(details.at(i));
+    }
+
+    QCOMPARE(targets.first()->type(), ChumPackage::PackageApplicationDesktop);
+    qDeleteAll(targets);
+}
+
+void BenchChum::modelReset_data() {
+    QTest::addColumn<int>("packages");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+// unfiltered list of all packages, sorted by name
+void BenchChum::modelReset() {
+    QFETCH(int, packages);
+    if (!m_bus) QSKIP("dbus-daemon is not available");
+    QVERIFY(catalog(packages));
+
+    ChumPackagesModel model;
+    model.componentComplete();
+    QBENCHMARK {
+        model.reset();
+    }
+    QCOMPARE(model.rowCount(), packages);
+}
+
+void BenchChum::search_data() {
+    QTest::addColumn<int>("packages");
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<bool>("trimmed");
+    QTest::newRow("1000 single letter") << 1000 << QStringLiteral("s") << false;
+    QTest::newRow("1000 word") << 1000 << QStringLiteral("synchronizes") << false;
+    QTest::newRow("10000 single letter") << 10000 << QStringLiteral("s") << false;
+    QTest::newRow("10000 word") << 10000 << QStringLiteral("synchronizes") << false;
+    QTest::newRow("10000 two words") << 10000 << QStringLiteral("amber synchronizes") << false;
+    // descriptions compressed by trim, last as they stay compressed
+    QTest::newRow("10000 word trimmed") << 10000 << QStringLiteral("synchronizes") << true;
+}
+
+// one keystroke per iteration, typing the last character of the query
+// and deleting it again in turn
+void BenchChum::search() {
+    QFETCH(int, packages);
+    QFETCH(QString, query);
+    QFETCH(bool, trimmed);
+    if (!m_bus) QSKIP("dbus-daemon is not available");
+    QVERIFY(catalog(packages));
+    if (trimmed)
+        for (ChumPackage *p: Chum::instance()->packages()) p->trim();
+    const QVariant restored = ChumPackage::trimStatistics().value(QStringLiteral("descriptionsRestored"));
+
+    ChumPackagesModel model;
+    model.componentComplete();
+    const QString previous = query.left(query.size() - 1);
+    model.setSearch(previous);
+    bool typed = false;
+    QBENCHMARK {
+        typed = !typed;
+        model.setSearch(typed ? query : previous);
+    }
+    model.setSearch(query);
+    QVERIFY(model.rowCount() > 0);
+    // search does not keep descriptions expanded
+    QCOMPARE(ChumPackage::trimStatistics().value(QStringLiteral("descriptionsRestored")), restored);
+}
+
+void BenchChum::parseIssues_data() {
+    QTest::addColumn<int>("issues");
+    QTest::newRow("page") << int(ProjectAbstract::pageSize);
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+// response of the GitHub issues query
+void BenchChum::parseIssues() {
+    QFETCH(int, issues);
+
+    QJsonArray nodes;
+    for (int i = 0; i < issues; ++i)
+        nodes.append(QJsonObject{
+                         {QStringLiteral("number"), i + 1},
+                         {QStringLiteral("title"), QStringLiteral("Crash when opening the settings page after update %1").arg(i)},
+                         {QStringLiteral("author"), QJsonObject{
+                              {QStringLiteral("login"), QStringLiteral("user%1").arg(i % 97)},
+                              {QStringLiteral("name"), QStringLiteral("User Name %1").arg(i % 97)}
+                          }},
+                         {QStringLiteral("createdAt"), QStringLiteral("2023-04-05T06:07:08Z")},
+                         {QStringLiteral("updatedAt"), QStringLiteral("2024-01-02T03:04:05Z")},
+                         {QStringLiteral("comments"), QJsonObject{{QStringLiteral("totalCount"), i % 13}}}
+                     });
+    const QJsonObject page{{QStringLiteral("hasNextPage"), true},
+                           {QStringLiteral("endCursor"), QStringLiteral("Y3Vyc29yOnYyOpK5")}};
+    const QJsonObject response{{QStringLiteral("data"), QJsonObject{
+                                    {QStringLiteral("repository"), QJsonObject{
+                                         {QStringLiteral("issues"), QJsonObject{
+                                              {QStringLiteral("pageInfo"), page},
+                                              {QStringLiteral("nodes"), nodes}
+                                          }}
+                                     }}
+                                }}};
+    const QByteArray data = QJsonDocument(response).toJson(QJsonDocument::Compact);
+
+    IssuesPage result;
+    QBENCHMARK {
+        result = ProjectGitHub::parseIssues(data);
+    }
+    QCOMPARE(result.items.size(), issues);
+    QCOMPARE(result.next_cursor, QStringLiteral("Y3Vyc29yOnYyOpK5"));
+}
+
+QTEST_GUILESS_MAIN(BenchChum)
+
+#include "bench_chum.moc"
@@ -0,0 +1,79 @@
+#include "chum.h"
+#include "refreshrunner.h"
+#include "tracer.h"
+
+#include <QtTest>
+
+// Full refresh of Chum, from the repository refresh to the update check,
+// against synthetic repositories of increasing size.
+//
+// refresh reports the wall time of the refresh. memory reports the
+// resident set size of the process after the refresh, which is only
+// meaningful when a single size is run per process:
+//
+//   bench_refresh refresh:1000 memory:1000 -o bench_refresh.csv,csv
+//
+// The benchmark target of the build runs all sizes in this way.
+class BenchRefresh : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void refresh_data();
+    void refresh();
+    void memory_data();
+    void memory();
+
+private:
+    RefreshRunner m_runner;
+    int           m_refreshed{-1}; // packages of the last refresh
+};
+
+void BenchRefresh::initTestCase() {
+    if (!m_runner.init())
+        QSKIP("dbus-daemon is not available");
+}
+
+void BenchRefresh::refresh_data() {
+    QTest::addColumn<int>("packages");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+void BenchRefresh::refresh() {
+    QFETCH(int, packages);
+    QVERIFY(m_runner.startServices(packages));
+
+    bool finished = false;
+    QBENCHMARK_ONCE {
+        finished = m_runner.refresh();
+    }
+    QVERIFY(finished);
+    QCOMPARE(Chum::instance()->packages().size(), packages);
+    m_refreshed = packages;
+}
+
+void BenchRefresh::memory_data() {
+    refresh_data();
+}
+
+void BenchRefresh::memory() {
+    QFETCH(int, packages);
+    if (m_refreshed != packages) {
+        QVERIFY(m_runner.startServices(packages));
+        QVERIFY(m_runner.refresh());
+        m_refreshed = packages;
+    }
+
+    const QVariantMap memory = Tracer::memoryUsage();
+    qInfo() << "Memory after refresh of" << packages << "packages:"
+            << "peak RSS" << memory.value(QStringLiteral("peak_rss_kb")).toLongLong() << "kB";
+    QTest::setBenchmarkResult(memory.value(QStringLiteral("rss_kb")).toLongLong() * 1024,
+                              QTest::BytesAllocated);
+}
+
+QTEST_GUILESS_MAIN(BenchRefresh)
+
+#include "bench_refresh.moc"
@@ -0,0 +1,199 @@
+#include "fakepackagekit.h"
+#include "syntheticrepo.h"
+
+#include <PackageKit/Transaction>
+
+#include <QDBusConnection>
+#include <QTimer>
+
+using PackageKit::Transaction;
+
+// items handled per iteration of the event loop
+static const int s_chunk{500};
+
+FakePackageKit::FakePackageKit(const SyntheticRepo *repo, QObject *parent)
+    : QObject{parent},
+      m_repo{repo}
+{
+    for (int i = 0; i < repo->packages().size(); ++i)
+        m_index.insert(repo->packages().at(i).name, i);
+}
+
+bool FakePackageKit::registerOn(const QString &address) {
+    m_connection = QStringLiteral("fake-packagekit");
+    QDBusConnection bus = QDBusConnection::connectToBus(address, m_connection);
+    return bus.registerObject(QStringLiteral("/org/freedesktop/PackageKit"), this,
+                              QDBusConnection::ExportAllSlots |
+                              QDBusConnection::ExportAllSignals |
+                              QDBusConnection::ExportAllProperties) &&
+            bus.registerService(QStringLiteral("org.freedesktop.PackageKit"));
+}
+
+QDBusObjectPath FakePackageKit::CreateTransaction() {
+    const QString path = QStringLiteral("/%1_fake").arg(++m_serial);
+    new FakeTransaction(this, path, m_connection);
+    return QDBusObjectPath(path);
+}
+
+////////////////////////////////////////////////////////////////////////
+
+FakeTransaction::FakeTransaction(FakePackageKit *daemon, const QString &path, const QString &connection)
+    : QObject{daemon},
+      m_daemon{daemon},
+      m_path{path},
+      m_connection{connection}
+{
+    m_timer.start();
+    m_status = Transaction::StatusWait;
+    QDBusConnection(m_connection).registerObject(path, this,
+                                                 QDBusConnection::ExportAllSlots |
+                                                 QDBusConnection::ExportAllSignals |
+                                                 QDBusConnection::ExportAllProperties);
+}
+
+void FakeTransaction::SetHints(const QStringList &hints) {
+    Q_UNUSED(hints)
+}
+
+// Packages of the repository installed in the available version are
+// listed only once, as installed
+void FakeTransaction::GetPackages(qulonglong filter) {
+    m_daemon->calls.append(QStringLiteral("GetPackages"));
+    const SyntheticRepo *repo = m_daemon->repo();
+    const int count = repo->packages().size();
+    const bool installed_only = filter & Transaction::FilterInstalled;
+    start(Transaction::RoleGetPackages, count + repo->others().size(), [this, repo, count, installed_only](int i) {
+        if (i >= count) {
+            const SyntheticRepo::Package &p = repo->others().at(i - count);
+            emit Package(Transaction::InfoInstalled, SyntheticRepo::installedId(p), p.summary);
+            return;
+        }
+        const SyntheticRepo::Package &p = repo->packages().at(i);
+        if (!installed_only && p.installed != p.version)
+            emit Package(Transaction::InfoAvailable, repo->availableId(p), p.summary);
+        if (!p.installed.isEmpty())
+            emit Package(Transaction::InfoInstalled, SyntheticRepo::installedId(p), p.summary);
+    });
+}
+
+void FakeTransaction::Resolve(qulonglong filter, const QStringList &packages) {
+    m_daemon->calls.append(QStringLiteral("Resolve"));
+    const SyntheticRepo *repo = m_daemon->repo();
+    const bool installed_only = filter & Transaction::FilterInstalled;
+    start(Transaction::RoleResolve, packages.size(), [this, repo, packages, installed_only](int i) {
+        const int index = m_daemon->indexOf(packages.at(i));
+        if (index < 0) return;
+        const SyntheticRepo::Package &p = repo->packages().at(index);
+        if (!p.installed.isEmpty())
+            emit Package(Transaction::InfoInstalled, SyntheticRepo::installedId(p), p.summary);
+        if (!installed_only && p.installed != p.version)
+            emit Package(Transaction::InfoAvailable, repo->availableId(p), p.summary);
+    });
+}
+
+// Only packages of the repository are provided under their own name
+void FakeTransaction::WhatProvides(qulonglong filter, const QStringList &values) {
+    Q_UNUSED(filter)
+    m_daemon->calls.append(QStringLiteral("WhatProvides"));
+    const SyntheticRepo *repo = m_daemon->repo();
+    start(Transaction::RoleWhatProvides, values.size(), [this, repo, values](int i) {
+        const int index = m_daemon->indexOf(values.at(i));
+        if (index < 0) return;
+        const SyntheticRepo::Package &p = repo->packages().at(index);
+        emit Package(p.installed == p.version ? Transaction::InfoInstalled : Transaction::InfoAvailable,
+                     repo->availableId(p), p.summary);
+    });
+}
+
+void FakeTransaction::GetDetails(const QStringList &package_ids) {
+    m_daemon->calls.append(QStringLiteral("GetDetails"));
+    const SyntheticRepo *repo = m_daemon->repo();
+    start(Transaction::RoleGetDetails, package_ids.size(), [this, repo, package_ids](int i) {
+        const QString &id = package_ids.at(i);
+        const int index = m_daemon->indexOf(id.section(QLatin1Char(';'), 0, 0));
+        if (index < 0) return;
+        const SyntheticRepo::Package &p = repo->packages().at(index);
+        emit Details(QVariantMap{
+                         {QStringLiteral("package-id"), id},
+                         {QStringLiteral("summary"), p.summary},
+                         {QStringLiteral("description"), p.description},
+                         {QStringLiteral("url"), p.url},
+                         {QStringLiteral("license"), p.license},
+                         {QStringLiteral("group"), uint(Transaction::GroupUnknown)},
+                         {QStringLiteral("size"), p.size}
+                     });
+    });
+}
+
+void FakeTransaction::GetUpdates(qulonglong filter) {
+    Q_UNUSED(filter)
+    m_daemon->calls.append(QStringLiteral("GetUpdates"));
+    const SyntheticRepo *repo = m_daemon->repo();
+    start(Transaction::RoleGetUpdates, repo->packages().size(), [this, repo](int i) {
+        const SyntheticRepo::Package &p = repo->packages().at(i);
+        if (!p.installed.isEmpty() && p.installed != p.version)
+            emit Package(Transaction::InfoNormal, repo->availableId(p), p.summary);
+    });
+}
+
+void FakeTransaction::GetFiles(const QStringList &package_ids) {
+    m_daemon->calls.append(QStringLiteral("GetFiles"));
+    start(Transaction::RoleGetFiles, package_ids.size(), [this, package_ids](int i) {
+        const QString &id = package_ids.at(i);
+        const QString name = id.section(QLatin1Char(';'), 0, 0);
+        emit Files(id, {QStringLiteral("/usr/bin/%1").arg(name),
+                        QStringLiteral("/usr/share/applications/%1.desktop").arg(name)});
+    });
+}
+
+void FakeTransaction::RepoSetData(const QString &repo_id, const QString &parameter, const QString &value) {
+    Q_UNUSED(parameter)
+    Q_UNUSED(value)
+    m_daemon->calls.append(QStringLiteral("RepoSetData"));
+    if (repo_id == m_daemon->repo()->alias()) {
+        start(Transaction::RoleRepoSetData, 0, nullptr);
+        return;
+    }
+    m_role = Transaction::RoleRepoSetData;
+    QTimer::singleShot(0, this, [this, repo_id]() {
+        emit ErrorCode(Transaction::ErrorRepoNotFound, QStringLiteral("Unknown repository %1").arg(repo_id));
+        this->finish(Transaction::ExitFailed);
+    });
+}
+
+void FakeTransaction::Cancel() {
+    m_daemon->calls.append(QStringLiteral("Cancel"));
+    m_cancelled = true;
+}
+
+void FakeTransaction::start(uint role, int count, const std::function<void(int)> &item) {
+    m_role = role;
+    m_status = Transaction::StatusRunning;
+    m_count = count;
+    m_item = item;
+    QTimer::singleShot(0, this, &FakeTransaction::step);
+}
+
+void FakeTransaction::step() {
+    if (m_cancelled) {
+        emit ErrorCode(Transaction::ErrorTransactionCancelled, QStringLiteral("The task was stopped successfully"));
+        finish(Transaction::ExitCancelled);
+        return;
+    }
+    const int end = qMin(m_count, m_next + s_chunk);
+    for (; m_next < end; ++m_next)
+        m_item(m_next);
+    m_percentage = m_count ? 100 * m_next / m_count : 100;
+    if (m_next < m_count)
+        QTimer::singleShot(0, this, &FakeTransaction::step);
+    else
+        finish(Transaction::ExitSuccess);
+}
+
+void FakeTransaction::finish(uint exit) {
+    m_status = Transaction::StatusFinished;
+    emit Finished(exit, uint(m_timer.elapsed()));
+    emit Destroy();
+    QDBusConnection(m_connection).unregisterObject(m_path);
+    deleteLater();
+}
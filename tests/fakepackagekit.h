@@ -0,0 +1,120 @@
+#ifndef FAKEPACKAGEKIT_H
+#define FAKEPACKAGEKIT_H
+
+#include <QDBusObjectPath>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QVariantMap>
+
+#include <functional>
+
+class SyntheticRepo;
+
+/// Stand-in for the PackageKit daemon answering queries from a
+/// synthetic repository. Every transaction is exported on the bus as a
+/// separate object, which emits its results in chunks from the event
+/// loop, so that a cancellation arrives in the middle of large results
+/// as it does with the real daemon. Package operations are not
+/// supported.
+class FakePackageKit : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.PackageKit")
+    Q_PROPERTY(uint VersionMajor READ versionMajor)
+    Q_PROPERTY(uint VersionMinor READ versionMinor)
+    Q_PROPERTY(uint VersionMicro READ versionMicro)
+    Q_PROPERTY(QString BackendName READ backendName)
+    Q_PROPERTY(bool Locked READ locked)
+
+public:
+    explicit FakePackageKit(const SyntheticRepo *repo, QObject *parent = nullptr);
+
+    // registers the service on its own connection to the bus
+    bool registerOn(const QString &address);
+
+    const SyntheticRepo *repo() const { return m_repo; }
+    // index of the package of the repository or -1
+    int indexOf(const QString &name) const { return m_index.value(name, -1); }
+
+    QStringList calls; // transaction methods in the order of the calls
+
+    uint versionMajor() const { return 1; }
+    uint versionMinor() const { return 1; }
+    uint versionMicro() const { return 12; }
+    QString backendName() const { return QStringLiteral("fake"); }
+    bool locked() const { return false; }
+
+public slots:
+    QDBusObjectPath CreateTransaction();
+
+signals:
+    void TransactionListChanged(const QStringList &transactions);
+    void UpdatesChanged();
+    void RepoListChanged();
+
+private:
+    const SyntheticRepo *m_repo;
+    QHash<QString, int>  m_index;
+    QString              m_connection;
+    uint                 m_serial{0};
+};
+
+class FakeTransaction : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.PackageKit.Transaction")
+    Q_PROPERTY(uint Role READ role)
+    Q_PROPERTY(uint Status READ status)
+    Q_PROPERTY(uint Percentage READ percentage)
+    Q_PROPERTY(bool AllowCancel READ allowCancel)
+
+public:
+    FakeTransaction(FakePackageKit *daemon, const QString &path, const QString &connection);
+
+    uint role() const { return m_role; }
+    uint status() const { return m_status; }
+    uint percentage() const { return m_percentage; }
+    bool allowCancel() const { return true; }
+
+public slots:
+    void SetHints(const QStringList &hints);
+    void GetPackages(qulonglong filter);
+    void Resolve(qulonglong filter, const QStringList &packages);
+    void WhatProvides(qulonglong filter, const QStringList &values);
+    void GetDetails(const QStringList &package_ids);
+    void GetUpdates(qulonglong filter);
+    void GetFiles(const QStringList &package_ids);
+    void RepoSetData(const QString &repo_id, const QString &parameter, const QString &value);
+    void Cancel();
+
+signals:
+    void Package(uint info, const QString &package_id, const QString &summary);
+    void Details(const QVariantMap &data);
+    void Files(const QString &package_id, const QStringList &file_list);
+    void ErrorCode(uint code, const QString &details);
+    void Finished(uint exit, uint runtime);
+    void Destroy();
+
+private:
+    // emits results for count items in chunks and finishes the transaction
+    void start(uint role, int count, const std::function<void(int)> &item);
+    void step();
+    void finish(uint exit);
+
+private:
+    FakePackageKit *m_daemon;
+    QString         m_path;
+    QString         m_connection;
+    QElapsedTimer   m_timer;
+    std::function<void(int)> m_item;
+    int  m_count{0};
+    int  m_next{0};
+    bool m_cancelled{false};
+    uint m_role{0};
+    uint m_status{0};
+    uint m_percentage{101};
+};
+
+#endif // FAKEPACKAGEKIT_H
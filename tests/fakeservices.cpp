@@ -0,0 +1,43 @@
+#include "fakepackagekit.h"
+#include "fakessu.h"
+#include "syntheticrepo.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+
+#include <cstdio>
+
+// Runs the stand-ins for SSU and PackageKit with a synthetic repository
+// on the bus given by DBUS_SYSTEM_BUS_ADDRESS, in a process of its own so
+// that the time and memory they take are not measured with the client.
+//
+// Usage: chum-fake-services <packages> [seed]
+// Prints "ready" once both services are registered.
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    bool ok = false;
+    const int count = args.value(1).toInt(&ok);
+    if (!ok || count < 0) {
+        qWarning() << "Usage: chum-fake-services <packages> [seed]";
+        return 1;
+    }
+    const uint seed = args.size() > 2 ? args.at(2).toUInt() : 1;
+    const QString address = QString::fromLocal8Bit(qgetenv("DBUS_SYSTEM_BUS_ADDRESS"));
+
+    const QString alias = QStringLiteral("sailfishos-chum");
+    SyntheticRepo repo(alias, count, seed);
+
+    FakeSsu ssu;
+    ssu.repos = {FakeSsu::Repo{QStringLiteral("adaptation0"), QStringLiteral("https://example.org/adaptation/"), {}},
+                 FakeSsu::Repo{alias, QStringLiteral("https://repo.sailfishos.org/obs/sailfishos:/chum/4.6_aarch64/"), {}}};
+    FakePackageKit packagekit(&repo);
+    if (!ssu.registerOn(address) || !packagekit.registerOn(address)) {
+        qWarning() << "Failed to register services on" << address;
+        return 1;
+    }
+
+    std::fputs("ready\n", stdout);
+    std::fflush(stdout);
+    return app.exec();
+}
@@ -0,0 +1,79 @@
+#include "fakessu.h"
+
+#include <QDBusArgument>
+#include <QDBusError>
+#include <QDBusMetaType>
+
+QDBusArgument &operator<<(QDBusArgument &arg, const FakeSsu::Repo &repo) {
+    arg.beginStructure();
+    arg << repo.name << repo.url << repo.parameters;
+    arg.endStructure();
+    return arg;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &arg, FakeSsu::Repo &repo) {
+    arg.beginStructure();
+    arg >> repo.name >> repo.url >> repo.parameters;
+    arg.endStructure();
+    return arg;
+}
+
+FakeSsu::FakeSsu(QObject *parent)
+    : QObject{parent}
+{
+    qDBusRegisterMetaType<Repo>();
+    qDBusRegisterMetaType<QList<Repo>>();
+}
+
+bool FakeSsu::registerOn(const QString &address) {
+    QDBusConnection bus = QDBusConnection::connectToBus(address, QStringLiteral("fake-ssu"));
+    return bus.registerObject(QStringLiteral("/org/nemo/ssu"), this, QDBusConnection::ExportAllSlots) &&
+            bus.registerService(QStringLiteral("org.nemo.ssu"));
+}
+
+QString FakeSsu::url(const QString &name) const {
+    for (const Repo &r: repos)
+        if (r.name == name) return r.url;
+    return QString{};
+}
+
+// records the call, returns false if it is answered with an error
+bool FakeSsu::call(const QString &method, const QStringList &args) {
+    QStringList parts{method};
+    parts += args;
+    calls.append(parts.join(QLatin1Char(' ')));
+    if (onCall) onCall(method);
+    if (method != failMethod) return true;
+    sendErrorReply(QDBusError::Failed, QStringLiteral("%1 failed").arg(method));
+    return false;
+}
+
+QList<FakeSsu::Repo> FakeSsu::listRepos(bool rnd) {
+    Q_UNUSED(rnd)
+    call(QStringLiteral("listRepos"), {});
+    return repos;
+}
+
+void FakeSsu::addRepo(const QString &repo, const QString &url) {
+    if (!call(QStringLiteral("addRepo"), {repo, url})) return;
+    remove(repo);
+    repos.append(Repo{repo, url, {}});
+}
+
+// only removal (action 0) is used
+void FakeSsu::modifyRepo(int action, const QString &repo) {
+    if (call(QStringLiteral("modifyRepo"), {QString::number(action), repo}) && action == 0)
+        remove(repo);
+}
+
+void FakeSsu::remove(const QString &name) {
+    for (int i = 0; i < repos.size(); ++i)
+        if (repos.at(i).name == name) {
+            repos.removeAt(i);
+            return;
+        }
+}
+
+void FakeSsu::updateRepos() {
+    call(QStringLiteral("updateRepos"), {});
+}
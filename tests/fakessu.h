@@ -0,0 +1,53 @@
+#ifndef FAKESSU_H
+#define FAKESSU_H
+
+#include <QDBusConnection>
+#include <QDBusContext>
+#include <QList>
+#include <QObject>
+#include <QStringList>
+#include <QVariantMap>
+
+#include <functional>
+
+/// Stand-in for the org.nemo.ssu service, keeping the repositories in
+/// memory. Calls are recorded and a hook runs when a call arrives, before
+/// it is answered.
+class FakeSsu : public QObject, protected QDBusContext
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.nemo.ssu")
+
+public:
+    struct Repo {
+        QString     name;
+        QString     url;
+        QVariantMap parameters;
+    };
+
+    explicit FakeSsu(QObject *parent = nullptr);
+
+    // registers the service on its own connection to the bus
+    bool registerOn(const QString &address);
+
+    QList<Repo> repos;
+    QStringList calls;                           // "method arg1 arg2"
+    std::function<void(const QString &)> onCall; // called with the method name
+    QString failMethod;                          // method answered with an error
+
+    QString url(const QString &name) const;
+
+public slots:
+    QList<FakeSsu::Repo> listRepos(bool rnd);
+    void addRepo(const QString &repo, const QString &url);
+    void modifyRepo(int action, const QString &repo);
+    void updateRepos();
+
+private:
+    bool call(const QString &method, const QStringList &args);
+    void remove(const QString &name);
+};
+
+Q_DECLARE_METATYPE(FakeSsu::Repo)
+
+#endif // FAKESSU_H
@@ -0,0 +1,29 @@
+#include "privatebus.h"
+
+#include <QDebug>
+
+static const int s_start_timeout{10000};
+
+PrivateBus::~PrivateBus() {
+    if (m_daemon.state() == QProcess::NotRunning) return;
+    m_daemon.terminate();
+    if (!m_daemon.waitForFinished(s_start_timeout))
+        m_daemon.kill();
+}
+
+bool PrivateBus::start() {
+    m_daemon.start(QStringLiteral("dbus-daemon"),
+                   {QStringLiteral("--session"), QStringLiteral("--nofork"), QStringLiteral("--print-address")});
+    if (!m_daemon.waitForStarted(s_start_timeout)) {
+        qWarning() << "Failed to start dbus-daemon:" << m_daemon.errorString();
+        return false;
+    }
+    while (!m_daemon.canReadLine())
+        if (!m_daemon.waitForReadyRead(s_start_timeout)) {
+            qWarning() << "No address printed by dbus-daemon";
+            return false;
+        }
+    m_address = QString::fromLatin1(m_daemon.readLine().trimmed());
+    qputenv("DBUS_SYSTEM_BUS_ADDRESS", m_address.toLatin1());
+    return true;
+}
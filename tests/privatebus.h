@@ -0,0 +1,25 @@
+#ifndef PRIVATEBUS_H
+#define PRIVATEBUS_H
+
+#include <QProcess>
+#include <QString>
+
+/// Message bus daemon run for tests. Once started, it is used as the
+/// system bus of the process, so services normally found there, such as
+/// SSU and PackageKit, can be replaced by stand-ins. It has to be started
+/// before the system bus is used for the first time.
+class PrivateBus
+{
+public:
+    ~PrivateBus();
+
+    // returns false if the daemon could not be started
+    bool start();
+    QString address() const { return m_address; }
+
+private:
+    QProcess m_daemon;
+    QString  m_address;
+};
+
+#endif // PRIVATEBUS_H
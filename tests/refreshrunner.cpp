@@ -0,0 +1,62 @@
+#include "refreshrunner.h"
+#include "chum.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QEventLoop>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QTimer>
+
+static const int s_timeout{300000};
+
+RefreshRunner::~RefreshRunner() {
+    stopServices();
+}
+
+bool RefreshRunner::init() {
+    if (!m_bus.start()) return false;
+
+    QStandardPaths::setTestMode(true);
+    QDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+         QStringLiteral("/sailfishos-chum-gui")).removeRecursively();
+    QSettings().clear();
+    return true;
+}
+
+bool RefreshRunner::startServices(int packages) {
+    stopServices();
+    m_services.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    m_services.start(QCoreApplication::applicationDirPath() + QStringLiteral("/chum-fake-services"),
+                     {QString::number(packages), QString::number(packages)});
+    if (!m_services.waitForStarted()) {
+        qWarning() << "Failed to start services:" << m_services.errorString();
+        return false;
+    }
+    while (!m_services.canReadLine())
+        if (!m_services.waitForReadyRead(s_timeout)) return false;
+    if (m_services.readLine().trimmed() != "ready") return false;
+    m_packages = packages;
+    return true;
+}
+
+void RefreshRunner::stopServices() {
+    m_packages = -1;
+    if (m_services.state() == QProcess::NotRunning) return;
+    m_services.terminate();
+    if (!m_services.waitForFinished())
+        m_services.kill();
+}
+
+bool RefreshRunner::refresh() {
+    Chum *chum = Chum::instance();
+    QEventLoop loop;
+    QTimer::singleShot(s_timeout, &loop, [&loop]() { loop.exit(1); });
+    QObject::connect(chum, &Chum::busyChanged, &loop, [&loop, chum]() {
+        if (!chum->busy()) loop.exit(0);
+    });
+    if (m_started) chum->refreshRepo();
+    m_started = true;
+    return loop.exec() == 0;
+}
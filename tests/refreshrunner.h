@@ -0,0 +1,38 @@
+#ifndef REFRESHRUNNER_H
+#define REFRESHRUNNER_H
+
+#include "privatebus.h"
+
+#include <QProcess>
+
+/// Runs refreshes of Chum against the stand-ins for SSU and PackageKit of
+/// chum-fake-services on a private bus. The services run in a separate
+/// process, restarted for every repository size with packages of other
+/// names, so that every refresh starts from an empty catalog. Caches and
+/// settings are kept in the test locations of QStandardPaths and there
+/// is no network access.
+class RefreshRunner
+{
+public:
+    ~RefreshRunner();
+
+    // has to be called before the system bus is used for the first time
+    bool init();
+
+    // runs the services with a synthetic repository of the given size
+    bool startServices(int packages);
+    void stopServices();
+    int  packages() const { return m_packages; }
+
+    // full refresh, the first one is started by the construction of
+    // Chum; returns false on timeout
+    bool refresh();
+
+private:
+    PrivateBus m_bus;
+    QProcess   m_services;
+    int        m_packages{-1};
+    bool       m_started{false};
+};
+
+#endif // REFRESHRUNNER_H
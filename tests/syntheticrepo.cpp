@@ -0,0 +1,135 @@
+#include "syntheticrepo.h"
+
+#include <QStringList>
+
+static const QStringList s_words{
+    QStringLiteral("amber"), QStringLiteral("birch"), QStringLiteral("cloud"), QStringLiteral("delta"),
+    QStringLiteral("ember"), QStringLiteral("fjord"), QStringLiteral("glide"), QStringLiteral("harbor"),
+    QStringLiteral("island"), QStringLiteral("juniper"), QStringLiteral("kestrel"), QStringLiteral("lumen"),
+    QStringLiteral("meadow"), QStringLiteral("nimbus"), QStringLiteral("orbit"), QStringLiteral("pine"),
+    QStringLiteral("quartz"), QStringLiteral("river"), QStringLiteral("sail"), QStringLiteral("tundra")
+};
+
+static const QStringList s_categories{
+    QStringLiteral("AudioVideo"), QStringLiteral("Development"), QStringLiteral("Education"),
+    QStringLiteral("Game"), QStringLiteral("Graphics"), QStringLiteral("Network"),
+    QStringLiteral("Office"), QStringLiteral("Science"), QStringLiteral("System"),
+    QStringLiteral("Utility"), QStringLiteral("Maps"), QStringLiteral("Library")
+};
+
+static const QStringList s_licenses{
+    QStringLiteral("GPLv3"), QStringLiteral("GPLv2+"), QStringLiteral("MIT"),
+    QStringLiteral("BSD-3-Clause"), QStringLiteral("LGPLv2.1"), QStringLiteral("Apache-2.0")
+};
+
+static const QString s_sentence{
+    QStringLiteral("The %1 component keeps track of %2 data and synchronizes it with the %3 service "
+                   "whenever a network connection becomes available. ")};
+
+SyntheticRepo::SyntheticRepo(const QString &alias, int count, uint seed)
+    : m_alias{alias},
+      m_state{seed}
+{
+    for (int i = 0; i < count; ++i) {
+        const QString word = s_words.at(next(s_words.size()));
+        const QString other = s_words.at(next(s_words.size()));
+        const QString suffix = QStringLiteral("s%1n%2").arg(seed).arg(i);
+
+        // applications, libraries with development packages and the rest
+        Package p;
+        QString type;
+        const int kind = i % 10;
+        if (kind < 4) {
+            p.name = QStringLiteral("harbour-%1-%2").arg(word, suffix);
+            type = QStringLiteral("desktop-application");
+        } else if (kind < 6) {
+            p.name = QStringLiteral("lib%1-%2").arg(word, suffix);
+            if (kind == 5) p.name += QStringLiteral("-devel");
+            type = QStringLiteral("library");
+        } else {
+            p.name = QStringLiteral("%1-%2-%3").arg(word, other, suffix);
+            type = kind == 6 ? QStringLiteral("console-application") : QStringLiteral("generic");
+        }
+
+        const uint major = next(5);
+        const uint minor = next(20);
+        const uint patch = next(10) + 1;
+        p.version = QStringLiteral("%1.%2.%3-1.%4.1").arg(major).arg(minor).arg(patch).arg(next(9) + 1);
+        p.arch = kind == 5 || kind == 9 ? QStringLiteral("noarch") : QStringLiteral("aarch64");
+        p.license = s_licenses.at(next(s_licenses.size()));
+        p.size = 20000 + next(5000000);
+
+        // about every eighth is installed, a third of those in an older version
+        const uint installed = next(24);
+        if (installed < 2)
+            p.installed = p.version;
+        else if (installed == 2)
+            p.installed = QStringLiteral("%1.%2.%3-1.1.1").arg(major).arg(minor).arg(patch - 1);
+
+        const QString project = QStringLiteral("https://github.com/dev%1/%2").arg(next(400)).arg(p.name);
+        p.url = project;
+        p.summary = QStringLiteral("%1 %2 for Sailfish OS").arg(word, other);
+
+        QString text;
+        const uint sentences = 2 + next(8);
+        for (uint s = 0; s < sentences; ++s) {
+            text += s_sentence.arg(s_words.at(next(s_words.size())),
+                                   s_words.at(next(s_words.size())),
+                                   s_words.at(next(s_words.size())));
+            if (s % 3 == 2) text += QStringLiteral("\n\n");
+        }
+
+        // metadata block as parsed by ChumPackage::setDetails
+        QString meta = QStringLiteral("PackageName: %1 %2\n"
+                                      "Type: %3\n"
+                                      "Categories:\n").arg(word, other, type);
+        const uint ncat = 1 + next(3);
+        for (uint c = 0; c < ncat; ++c)
+            meta += QStringLiteral(" - %1\n").arg(s_categories.at(next(s_categories.size())));
+        meta += QStringLiteral("DeveloperName: Developer %1\n"
+                               "PackagedBy: packager%2\n"
+                               "Custom:\n"
+                               "  Repo: %3\n"
+                               "  PackagingRepo: https://github.com/sailfishos-chum/%4\n"
+                               "Icon: %3/raw/master/icons/172x172/%4.png\n"
+                               "Screenshots:\n"
+                               " - %3/raw/master/screenshots/main.png\n"
+                               " - %3/raw/master/screenshots/settings.png\n"
+                               "Url:\n"
+                               "  Homepage: %3\n"
+                               "  Help: %3/wiki\n"
+                               "  Bugtracker: %3/issues\n")
+                .arg(next(400)).arg(next(50)).arg(project, p.name);
+        p.description = text.trimmed() + QStringLiteral("\n\n") + meta;
+
+        m_packages.append(p);
+    }
+
+    // installed packages of other repositories, checked by the refresh
+    // for packages provided by the repository
+    const int others = qMax(50, count / 5);
+    for (int i = 0; i < others; ++i) {
+        Package p;
+        p.name = QStringLiteral("system-%1-s%2n%3").arg(s_words.at(next(s_words.size()))).arg(seed).arg(i);
+        p.installed = QStringLiteral("%1.%2-1.1.1").arg(next(5)).arg(next(20));
+        p.arch = QStringLiteral("aarch64");
+        p.summary = QStringLiteral("System package %1").arg(i);
+        p.license = s_licenses.at(next(s_licenses.size()));
+        p.size = 20000 + next(500000);
+        m_others.append(p);
+    }
+}
+
+QString SyntheticRepo::availableId(const Package &p) const {
+    return QStringLiteral("%1;%2;%3;%4").arg(p.name, p.version, p.arch, m_alias);
+}
+
+QString SyntheticRepo::installedId(const Package &p) {
+    return QStringLiteral("%1;%2;%3;installed").arg(p.name, p.installed, p.arch);
+}
+
+// linear congruential generator, same sequence on every platform
+uint SyntheticRepo::next(uint n) {
+    m_state = m_state * 1103515245u + 12345u;
+    return ((m_state >> 16) & 0x7fff) % n;
+}
@@ -0,0 +1,52 @@
+#ifndef SYNTHETICREPO_H
+#define SYNTHETICREPO_H
+
+#include <QList>
+#include <QString>
+
+/// Generated repository resembling SailfishOS:Chum: applications,
+/// libraries with development packages and other packages with
+/// descriptions ending in a metadata block as written by packagers.
+/// Some of the packages are installed, some of them in an older version.
+/// Installed packages of other repositories are generated as well.
+/// The same count and seed give the same packages; the seed is part of
+/// the package names, so that repositories of different seeds do not
+/// share packages.
+class SyntheticRepo
+{
+public:
+    struct Package {
+        QString name;
+        QString version;   // available version, empty for packages of other repositories
+        QString installed; // installed version, empty if not installed
+        QString arch;
+        QString summary;
+        QString description;
+        QString url;
+        QString license;
+        quint64 size{0};
+    };
+
+    SyntheticRepo(const QString &alias, int count, uint seed = 1);
+
+    QString alias() const { return m_alias; }
+    // packages of the repository
+    const QList<Package>& packages() const { return m_packages; }
+    // installed packages of other repositories
+    const QList<Package>& others() const { return m_others; }
+
+    // PackageKit ID of the available or installed version
+    QString availableId(const Package &p) const;
+    static QString installedId(const Package &p);
+
+private:
+    uint next(uint n); // pseudo-random number below n
+
+private:
+    QString        m_alias;
+    QList<Package> m_packages;
+    QList<Package> m_others;
+    uint           m_state;
+};
+
+#endif // SYNTHETICREPO_H
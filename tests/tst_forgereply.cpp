@@ -0,0 +1,218 @@
+#include "forgereply.h"
+#include "main.h"
+
+#include <QtTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+// HTTP server answering by path: /stall never responds, /fail responds
+// with 503 to the first requests, /slow delays the first response, /late
+// fails the first request and delays the next ones and everything else
+// succeeds at once
+class HttpServer : public QTcpServer
+{
+public:
+    HttpServer() {
+        connect(this, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket *socket = nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { this->read(socket); });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+        listen(QHostAddress::LocalHost);
+    }
+
+    QUrl url(const QString &path) const {
+        return QUrl(QStringLiteral("http://127.0.0.1:%1%2").arg(serverPort()).arg(path));
+    }
+
+    int  hits(const QString &path) const { return m_hits.value(path); }
+
+    int  failures{0}; // responses with 503 to /fail before succeeding
+    int  slow_ms{0};  // delay of the first response to /slow
+    int  late_ms{0};  // delay of the responses to /late after the first
+
+private:
+    void read(QTcpSocket *socket) {
+        QByteArray &buffer = m_buffers[socket];
+        buffer += socket->readAll();
+        if (!buffer.contains("\r\n\r\n")) return;
+        const QString path = QString::fromLatin1(buffer.split(' ').value(1));
+        m_buffers.remove(socket);
+        const int hit = ++m_hits[path];
+
+        if (path == QLatin1String("/stall"))
+            return;
+        if (path == QLatin1String("/fail") && hit <= failures)
+            respond(socket, "503 Service Unavailable", "failed");
+        else if (path == QLatin1String("/slow") && hit == 1)
+            QTimer::singleShot(slow_ms, socket, [this, socket]() { this->respond(socket, "200 OK", "slow"); });
+        else if (path == QLatin1String("/late") && hit == 1)
+            respond(socket, "503 Service Unavailable", "failed");
+        else if (path == QLatin1String("/late"))
+            QTimer::singleShot(late_ms, socket, [this, socket]() { this->respond(socket, "200 OK", "late"); });
+        else
+            respond(socket, "200 OK", "ok");
+    }
+
+    void respond(QTcpSocket *socket, const QByteArray &status, const QByteArray &body) {
+        if (socket->state() != QAbstractSocket::ConnectedState) return;
+        socket->write("HTTP/1.1 " + status + "\r\n"
+                      "Content-Type: text/plain\r\n"
+                      "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                      "Connection: close\r\n\r\n" + body);
+        socket->disconnectFromHost();
+    }
+
+private:
+    QHash<QString, int> m_hits;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+};
+
+class TestForgeReply : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void success();
+    void retryAfterFailures();
+    void failureAfterRetries();
+    void timeout();
+    void timeoutOfFailedAttempt();
+    void hedge();
+
+private:
+    // runs the request until finished, replies are deleted with the network manager
+    ForgeReply* run(const QString &path, const QString &backend, const RequestPolicy &policy);
+    QVariantMap stats(const QString &backend) const;
+
+private:
+    HttpServer m_server;
+};
+
+void TestForgeReply::initTestCase() {
+    QVERIFY(m_server.isListening());
+    nMng = new QNetworkAccessManager(this);
+}
+
+ForgeReply* TestForgeReply::run(const QString &path, const QString &backend, const RequestPolicy &policy) {
+    ForgeReply *reply = ForgeReply::get(QNetworkRequest(m_server.url(path)), backend, policy);
+    QSignalSpy finished(reply, &QNetworkReply::finished);
+    if (!finished.wait(20000)) return nullptr;
+    return reply;
+}
+
+QVariantMap TestForgeReply::stats(const QString &backend) const {
+    return ForgeReply::statistics().value(backend + QStringLiteral("/127.0.0.1")).toMap();
+}
+
+void TestForgeReply::success() {
+    RequestPolicy policy;
+    ForgeReply *reply = run(QStringLiteral("/ok"), QStringLiteral("success"), policy);
+    QVERIFY(reply);
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 200);
+    QCOMPARE(reply->readAll(), QByteArray("ok"));
+
+    const QVariantMap s = stats(QStringLiteral("success"));
+    QCOMPARE(s.value(QStringLiteral("requests")).toInt(), 1);
+    QCOMPARE(s.value(QStringLiteral("retries")).toInt(), 0);
+    QCOMPARE(s.value(QStringLiteral("hedges")).toInt(), 0);
+}
+
+void TestForgeReply::retryAfterFailures() {
+    m_server.failures = 2;
+    RequestPolicy policy;
+    policy.retries = 2;
+    policy.backoff_ms = 10;
+    ForgeReply *reply = run(QStringLiteral("/fail"), QStringLiteral("retry"), policy);
+    QVERIFY(reply);
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->readAll(), QByteArray("ok"));
+    QCOMPARE(m_server.hits(QStringLiteral("/fail")), 3);
+
+    const QVariantMap s = stats(QStringLiteral("retry"));
+    QCOMPARE(s.value(QStringLiteral("requests")).toInt(), 1);
+    QCOMPARE(s.value(QStringLiteral("retries")).toInt(), 2);
+    QCOMPARE(s.value(QStringLiteral("errors")).toInt(), 0);
+}
+
+void TestForgeReply::failureAfterRetries() {
+    const int hits = m_server.hits(QStringLiteral("/fail"));
+    m_server.failures = hits + 10;
+    RequestPolicy policy;
+    policy.retries = 2;
+    policy.backoff_ms = 10;
+    ForgeReply *reply = run(QStringLiteral("/fail"), QStringLiteral("failure"), policy);
+    QVERIFY(reply);
+    QCOMPARE(reply->error(), QNetworkReply::ServiceUnavailableError);
+    QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 503);
+    QCOMPARE(m_server.hits(QStringLiteral("/fail")), hits + 3);
+
+    const QVariantMap s = stats(QStringLiteral("failure"));
+    QCOMPARE(s.value(QStringLiteral("requests")).toInt(), 1);
+    QCOMPARE(s.value(QStringLiteral("retries")).toInt(), 2);
+    QCOMPARE(s.value(QStringLiteral("errors")).toInt(), 1);
+}
+
+void TestForgeReply::timeout() {
+    RequestPolicy policy;
+    policy.timeout_ms = 200;
+    policy.retries = 1;
+    policy.backoff_ms = 10;
+    ForgeReply *reply = run(QStringLiteral("/stall"), QStringLiteral("timeout"), policy);
+    QVERIFY(reply);
+    QCOMPARE(reply->error(), QNetworkReply::TimeoutError);
+    QCOMPARE(m_server.hits(QStringLiteral("/stall")), 2);
+
+    const QVariantMap s = stats(QStringLiteral("timeout"));
+    QCOMPARE(s.value(QStringLiteral("timeouts")).toInt(), 2);
+    QCOMPARE(s.value(QStringLiteral("retries")).toInt(), 1);
+    QCOMPARE(s.value(QStringLiteral("errors")).toInt(), 1);
+}
+
+// the timeout of a failed attempt does not abort the retry, even if the
+// retry got the address of the deleted reply
+void TestForgeReply::timeoutOfFailedAttempt() {
+    RequestPolicy policy;
+    policy.timeout_ms = 2000;
+    policy.retries = 1;
+    policy.backoff_ms = 400;
+    // the retry starts 200 to 400 ms after the failure and finishes after
+    // the timeout of the failed attempt, but within its own
+    m_server.late_ms = 1900;
+    ForgeReply *reply = run(QStringLiteral("/late"), QStringLiteral("stale"), policy);
+    QVERIFY(reply);
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->readAll(), QByteArray("late"));
+    QCOMPARE(m_server.hits(QStringLiteral("/late")), 2);
+
+    const QVariantMap s = stats(QStringLiteral("stale"));
+    QCOMPARE(s.value(QStringLiteral("timeouts")).toInt(), 0);
+    QCOMPARE(s.value(QStringLiteral("retries")).toInt(), 1);
+}
+
+void TestForgeReply::hedge() {
+    m_server.slow_ms = 3000;
+    RequestPolicy policy;
+    policy.hedge_after_ms = 100;
+    QElapsedTimer timer;
+    timer.start();
+    ForgeReply *reply = run(QStringLiteral("/slow"), QStringLiteral("hedge"), policy);
+    QVERIFY(reply);
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    // response of the duplicate is used
+    QCOMPARE(reply->readAll(), QByteArray("ok"));
+    QVERIFY(timer.elapsed() < m_server.slow_ms);
+    QCOMPARE(m_server.hits(QStringLiteral("/slow")), 2);
+
+    const QVariantMap s = stats(QStringLiteral("hedge"));
+    QCOMPARE(s.value(QStringLiteral("hedges")).toInt(), 1);
+    QCOMPARE(s.value(QStringLiteral("hedgeWins")).toInt(), 1);
+    QCOMPARE(s.value(QStringLiteral("retries")).toInt(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestForgeReply)
+
+#include "tst_forgereply.moc"
@@ -0,0 +1,129 @@
+#include "rpmversion.h"
+
+#include <QtTest>
+
+// Cases follow the rpmvercmp tests of rpm (tests/rpmvercmp.at). Every pair
+// is also checked in reverse order.
+class TestRpmVersion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void compare_data();
+    void compare();
+    void compareEvr_data();
+    void compareEvr();
+};
+
+static void addRow(const char *a, const char *b, int result) {
+    QTest::newRow(QByteArray(a).append(" vs ").append(b).constData())
+            << QString::fromLatin1(a) << QString::fromLatin1(b) << result;
+}
+
+void TestRpmVersion::compare_data() {
+    QTest::addColumn<QString>("a");
+    QTest::addColumn<QString>("b");
+    QTest::addColumn<int>("result");
+
+    // numeric segments
+    addRow("1.0", "1.0", 0);
+    addRow("1.0", "2.0", -1);
+    addRow("2.0.1", "2.0.1", 0);
+    addRow("2.0", "2.0.1", -1);
+    addRow("4.999.9", "5.0", -1);
+    addRow("20101121", "20101122", -1);
+
+    // leading zeros
+    addRow("10.0001", "10.0001", 0);
+    addRow("10.0001", "10.1", 0);
+    addRow("10.0001", "10.0039", -1);
+    addRow("1.00", "1.0", 0);
+    addRow("1.010", "1.9", 1);
+
+    // alphanumeric segments
+    addRow("2.0.1a", "2.0.1a", 0);
+    addRow("2.0.1", "2.0.1a", -1);
+    addRow("5.5p1", "5.5p2", -1);
+    addRow("5.5p1", "5.5p10", -1);
+    addRow("5.5p2", "5.6p1", -1);
+    addRow("5.6p1", "6.5p1", -1);
+    addRow("10xyz", "10.1xyz", -1);
+    addRow("xyz10", "xyz10.1", -1);
+    addRow("xyz.4", "8", -1);
+    addRow("xyz.4", "2", -1);
+    addRow("6.0", "6.0.rc1", -1);
+    addRow("10a2", "10b2", -1);
+    addRow("1.0a", "1.0aa", -1);
+
+    // separators are equal to each other
+    addRow("2.0", "2_0", 0);
+    addRow("a+", "a_", 0);
+    addRow("+a", "_a", 0);
+    addRow("_+", "_", 0);
+    addRow("+", "_", 0);
+
+    // tilde sorts before everything, including the end
+    addRow("1.0~rc1", "1.0~rc1", 0);
+    addRow("1.0~rc1", "1.0", -1);
+    addRow("1.0~rc1", "1.0~rc2", -1);
+    addRow("1.0~rc1~git123", "1.0~rc1", -1);
+
+    // caret sorts after the end, but before anything else
+    addRow("1.0^", "1.0^", 0);
+    addRow("1.0", "1.0^", -1);
+    addRow("1.0", "1.0^git1", -1);
+    addRow("1.0^git1", "1.0^git2", -1);
+    addRow("1.0^git1", "1.01", -1);
+    addRow("1.0^20160101", "1.0.1", -1);
+    addRow("1.0^20160101^git1", "1.0^20160102", -1);
+
+    // tilde and caret together
+    addRow("1.0~rc1", "1.0~rc1^git1", -1);
+    addRow("1.0^git1~pre", "1.0^git1", -1);
+}
+
+void TestRpmVersion::compare() {
+    QFETCH(QString, a);
+    QFETCH(QString, b);
+    QFETCH(int, result);
+
+    QCOMPARE(RpmVersion::compare(a, b), result);
+    QCOMPARE(RpmVersion::compare(b, a), -result);
+}
+
+void TestRpmVersion::compareEvr_data() {
+    QTest::addColumn<QString>("a");
+    QTest::addColumn<QString>("b");
+    QTest::addColumn<int>("result");
+
+    addRow("1.0-1", "1.0-1", 0);
+    addRow("1.0-1", "1.0-2", -1);
+    addRow("1.0-2", "1.0-10", -1);
+    addRow("1.0-10", "1.1-1", -1);
+    addRow("1.0~rc1-5", "1.0-1", -1);
+    addRow("1.0-1.1", "1.0-1.1.2", -1);
+
+    // epoch, missing one is 0
+    addRow("0:1.0-1", "1.0-1", 0);
+    addRow("1:1.0-1", "2.0-1", 1);
+    addRow("9:2.0-1", "10:1.0-1", -1);
+    addRow("1:1.0", "1:1.0-1", 0);
+
+    // release is only compared if given for both
+    addRow("1.0", "1.0-5", 0);
+    addRow("1.0", "1.1-1", -1);
+    addRow("2.0", "1.0-9", 1);
+}
+
+void TestRpmVersion::compareEvr() {
+    QFETCH(QString, a);
+    QFETCH(QString, b);
+    QFETCH(int, result);
+
+    QCOMPARE(RpmVersion::compareEvr(a, b), result);
+    QCOMPARE(RpmVersion::compareEvr(b, a), -result);
+}
+
+QTEST_APPLESS_MAIN(TestRpmVersion)
+
+#include "tst_rpmversion.moc"
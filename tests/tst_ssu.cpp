@@ -0,0 +1,264 @@
+#include "fakessu.h"
+#include "privatebus.h"
+#include "ssu.h"
+
+#include <QtTest>
+
+static const QString s_regular{QStringLiteral("sailfishos-chum")};
+static const QString s_regular_url{QStringLiteral("https://repo.sailfishos.org/obs/sailfishos:/chum/4.6_aarch64/")};
+static const QString s_testing{QStringLiteral("sailfishos-chum-testing")};
+static const QString s_testing_prefix{QStringLiteral("https://repo.sailfishos.org/obs/sailfishos:/chum:/testing/")};
+
+// Repository changes of Ssu against a stand-in SSU service on a private bus
+class TestSsu : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void load();
+    void switchToTesting();
+    void rejectWhileBusy();
+    void cancelAfterRemove();
+    void cancelAfterAdd();
+    void cancelWhileUpdating();
+    void failure();
+    void failureAfterRemove();
+    void failureWhileUpdating();
+    void failureOfRestore();
+
+private:
+    // methods called on the service, without arguments
+    QStringList methods() const;
+    void verifyRestored();
+
+private:
+    PrivateBus      m_bus;
+    FakeSsu        *m_service{nullptr};
+    Ssu            *m_ssu{nullptr};
+    QList<Ssu::Step> m_steps;
+};
+
+void TestSsu::initTestCase() {
+    if (!m_bus.start())
+        QSKIP("dbus-daemon is not available");
+    m_service = new FakeSsu(this);
+    QVERIFY(m_service->registerOn(m_bus.address()));
+}
+
+void TestSsu::init() {
+    m_service->repos = {FakeSsu::Repo{QStringLiteral("adaptation0"), QStringLiteral("https://example.org/adaptation/"), {}},
+                        FakeSsu::Repo{s_regular, s_regular_url, {}}};
+    m_service->onCall = nullptr;
+    m_service->failMethod.clear();
+
+    m_ssu = new Ssu(this);
+    QSignalSpy updated(m_ssu, &Ssu::updated);
+    m_ssu->loadRepos();
+    QVERIFY(updated.wait());
+
+    m_service->calls.clear();
+    connect(m_ssu, &Ssu::stepChanged, this, [this]() { m_steps.append(m_ssu->step()); });
+}
+
+void TestSsu::cleanup() {
+    delete m_ssu;
+    m_ssu = nullptr;
+    m_steps.clear();
+}
+
+QStringList TestSsu::methods() const {
+    QStringList result;
+    for (const QString &c: m_service->calls)
+        result.append(c.section(QLatin1Char(' '), 0, 0));
+    return result;
+}
+
+// the regular repository is set up again after a cancelled or failed change
+void TestSsu::verifyRestored() {
+    QCOMPARE(m_service->repos.size(), 2);
+    QCOMPARE(m_service->repos.last().name, s_regular);
+    QVERIFY(m_service->url(s_testing).isEmpty());
+    QVERIFY(m_ssu->manageRepo());
+    QCOMPARE(m_ssu->repoName(), s_regular);
+    QVERIFY(!m_ssu->repoTesting());
+    QCOMPARE(m_ssu->step(), Ssu::StepIdle);
+}
+
+void TestSsu::load() {
+    QVERIFY(m_ssu->manageRepo());
+    QVERIFY(m_ssu->repoAvailable());
+    QVERIFY(!m_ssu->repoTesting());
+    QCOMPARE(m_ssu->repoName(), s_regular);
+    QCOMPARE(m_ssu->repoUrl(), s_regular_url);
+
+    // nothing to cancel
+    QSignalSpy cancelled(m_ssu, &Ssu::cancelled);
+    m_ssu->cancel();
+    QVERIFY(m_service->calls.isEmpty());
+    QCOMPARE(cancelled.count(), 0);
+}
+
+void TestSsu::switchToTesting() {
+    QSignalSpy updated(m_ssu, &Ssu::updated);
+    QVERIFY(m_ssu->setRepo(QString(), true));
+    QVERIFY(m_ssu->changing());
+    QVERIFY(updated.wait());
+
+    QCOMPARE(m_steps, (QList<Ssu::Step>{Ssu::StepRemoveRepo, Ssu::StepAddRepo, Ssu::StepUpdateRepos,
+                                        Ssu::StepListRepos, Ssu::StepIdle}));
+    QCOMPARE(methods(), (QStringList{QStringLiteral("modifyRepo"), QStringLiteral("addRepo"),
+                                     QStringLiteral("updateRepos"), QStringLiteral("listRepos")}));
+    QCOMPARE(m_service->calls.first(), QStringLiteral("modifyRepo 0 ") + s_regular);
+    QVERIFY(m_service->url(s_testing).startsWith(s_testing_prefix));
+    QVERIFY(m_service->url(s_regular).isEmpty());
+
+    QVERIFY(m_ssu->manageRepo());
+    QVERIFY(m_ssu->repoTesting());
+    QCOMPARE(m_ssu->repoName(), s_testing);
+}
+
+void TestSsu::rejectWhileBusy() {
+    QSignalSpy updated(m_ssu, &Ssu::updated);
+    QVERIFY(m_ssu->setRepo(QString(), true));
+    QVERIFY(!m_ssu->setRepo(QStringLiteral("4.5.0.19"), false));
+    QVERIFY(updated.wait());
+
+    // only the first change was made
+    QCOMPARE(methods().count(QStringLiteral("addRepo")), 1);
+    QCOMPARE(m_ssu->repoName(), s_testing);
+    QVERIFY(m_ssu->manageRepo());
+
+    // accepted again once idle
+    QVERIFY(m_ssu->setRepo(QString(), false));
+    QVERIFY(updated.wait());
+    QCOMPARE(m_ssu->repoName(), s_regular);
+}
+
+void TestSsu::cancelAfterRemove() {
+    QSignalSpy updated(m_ssu, &Ssu::updated);
+    QSignalSpy cancelled(m_ssu, &Ssu::cancelled);
+    QVERIFY(m_ssu->setRepo(QString(), true));
+    m_ssu->cancel();
+    QVERIFY(updated.wait());
+
+    QCOMPARE(cancelled.count(), 1);
+    QCOMPARE(m_steps, (QList<Ssu::Step>{Ssu::StepRemoveRepo, Ssu::StepRestoreRepo,
+                                        Ssu::StepListRepos, Ssu::StepIdle}));
+    QCOMPARE(methods(), (QStringList{QStringLiteral("modifyRepo"), QStringLiteral("addRepo"),
+                                     QStringLiteral("updateRepos"), QStringLiteral("listRepos")}));
+    QVERIFY(m_service->calls.at(1).startsWith(QStringLiteral("addRepo ") + s_regular + QLatin1Char(' ')));
+    verifyRestored();
+}
+
+void TestSsu::cancelAfterAdd() {
+    m_service->onCall = [this](const QString &method) {
+        if (method == QLatin1String("addRepo")) m_ssu->cancel();
+    };
+    QSignalSpy updated(m_ssu, &Ssu::updated);
+    QSignalSpy cancelled(m_ssu, &Ssu::cancelled);
+    QVERIFY(m_ssu->setRepo(QString(), true));
+    QVERIFY(updated.wait());
+
+    QCOMPARE(cancelled.count(), 1);
+    // added repository is removed before the previous one is added
+    QCOMPARE(methods(), (QStringList{QStringLiteral("modifyRepo"), QStringLiteral("addRepo"),
+                                     QStringLiteral("modifyRepo"), QStringLiteral("addRepo"),
+                                     QStringLiteral("updateRepos"), QStringLiteral("listRepos")}));
+    QCOMPARE(m_service->calls.at(2), QStringLiteral("modifyRepo 0 ") + s_testing);
+    verifyRestored();
+}
+
+void TestSsu::cancelWhileUpdating() {
+    m_service->onCall = [this](const QString &method) {
+        if (method == QLatin1String("updateRepos")) m_ssu->cancel();
+    };
+    QSignalSpy updated(m_ssu, &Ssu::updated);
+    QSignalSpy cancelled(m_ssu, &Ssu::cancelled);
+    QVERIFY(m_ssu->setRepo(QString(), true));
+    QVERIFY(updated.wait());
+
+    QCOMPARE(cancelled.count(), 1);
+    QCOMPARE(methods(), (QStringList{QStringLiteral("modifyRepo"), QStringLiteral("addRepo"),
+                                     QStringLiteral("updateRepos"), QStringLiteral("modifyRepo"),
+                                     QStringLiteral("addRepo"), QStringLiteral("updateRepos"),
+                                     QStringLiteral("listRepos")}));
+    verifyRestored();
+}
+
+void TestSsu::failure() {
+    m_service->failMethod = QStringLiteral("modifyRepo");
+    QSignalSpy updated(m_ssu, &Ssu::updated);
+    QSignalSpy failed(m_ssu, &Ssu::failed);
+    QVERIFY(m_ssu->setRepo(QString(), true));
+    QVERIFY(updated.wait());
+
+    // aborted after the failed step, repositories are reloaded
+    QCOMPARE(failed.count(), 1);
+    QCOMPARE(methods(), (QStringList{QStringLiteral("modifyRepo"), QStringLiteral("listRepos")}));
+    verifyRestored();
+}
+
+// the previous repository is added again if adding the new one fails
+void TestSsu::failureAfterRemove() {
+    int additions = 0;
+    m_service->onCall = [this, &additions](const QString &method) {
+        if (method != QLatin1String("addRepo")) return;
+        m_service->failMethod = ++additions == 1 ? method : QString();
+    };
+    QSignalSpy updated(m_ssu, &Ssu::updated);
+    QSignalSpy failed(m_ssu, &Ssu::failed);
+    QVERIFY(m_ssu->setRepo(QString(), true));
+    QVERIFY(updated.wait());
+
+    QCOMPARE(failed.count(), 1);
+    QCOMPARE(m_steps, (QList<Ssu::Step>{Ssu::StepRemoveRepo, Ssu::StepAddRepo, Ssu::StepRestoreRepo,
+                                        Ssu::StepListRepos, Ssu::StepIdle}));
+    QCOMPARE(methods(), (QStringList{QStringLiteral("modifyRepo"), QStringLiteral("addRepo"),
+                                     QStringLiteral("addRepo"), QStringLiteral("updateRepos"),
+                                     QStringLiteral("listRepos")}));
+    QVERIFY(m_service->calls.at(2).startsWith(QStringLiteral("addRepo ") + s_regular + QLatin1Char(' ')));
+    verifyRestored();
+}
+
+void TestSsu::failureWhileUpdating() {
+    int updates = 0;
+    m_service->onCall = [this, &updates](const QString &method) {
+        if (method != QLatin1String("updateRepos")) return;
+        m_service->failMethod = ++updates == 1 ? method : QString();
+    };
+    QSignalSpy updated(m_ssu, &Ssu::updated);
+    QSignalSpy failed(m_ssu, &Ssu::failed);
+    QVERIFY(m_ssu->setRepo(QString(), true));
+    QVERIFY(updated.wait());
+
+    QCOMPARE(failed.count(), 1);
+    QCOMPARE(methods(), (QStringList{QStringLiteral("modifyRepo"), QStringLiteral("addRepo"),
+                                     QStringLiteral("updateRepos"), QStringLiteral("modifyRepo"),
+                                     QStringLiteral("addRepo"), QStringLiteral("updateRepos"),
+                                     QStringLiteral("listRepos")}));
+    verifyRestored();
+}
+
+// a failed rollback leaves the repository missing, but still managed
+void TestSsu::failureOfRestore() {
+    m_service->failMethod = QStringLiteral("addRepo");
+    QSignalSpy updated(m_ssu, &Ssu::updated);
+    QSignalSpy failed(m_ssu, &Ssu::failed);
+    QVERIFY(m_ssu->setRepo(QString(), true));
+    QVERIFY(updated.wait());
+
+    QCOMPARE(failed.count(), 2);
+    QCOMPARE(methods(), (QStringList{QStringLiteral("modifyRepo"), QStringLiteral("addRepo"),
+                                     QStringLiteral("addRepo"), QStringLiteral("listRepos")}));
+    QVERIFY(m_ssu->manageRepo());
+    QVERIFY(!m_ssu->repoAvailable());
+    QCOMPARE(m_ssu->step(), Ssu::StepIdle);
+}
+
+QTEST_GUILESS_MAIN(TestSsu)
+
+#include "tst_ssu.moc"